@@ -0,0 +1,277 @@
+#ifndef ABONAMENT_H
+#define ABONAMENT_H
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include "Bani.h"
+#include "Data.h"
+
+enum StareAbonament { NEPROCURAT, PROCURAT, ACTIV, EXPIRAT };
+
+class Abonament {
+protected:
+    std::string tip;
+    int durata;
+    Bani pret;
+    StareAbonament stare;
+    Data dataProcurarii;
+    Data dataActivarii;
+    Data dataExpirarii;
+
+public:
+    Abonament()
+        : tip("Standard"), durata(1), pret(), stare(NEPROCURAT) {}
+
+    Abonament(std::string t, int d, Bani p)
+        : tip(t), durata(d), pret(p), stare(NEPROCURAT) {}
+
+    Abonament(const Abonament&) = default;
+    Abonament(Abonament&&) noexcept = default;
+    Abonament& operator=(const Abonament&) = default;
+    Abonament& operator=(Abonament&&) noexcept = default;
+    virtual ~Abonament() {}
+
+    std::string getTip() const { return tip; }
+    int getDurata() const { return durata; }
+    Bani getPret() const { return pret; }
+    StareAbonament getStare() const { return stare; }
+    Data getDataProcurarii() const { return dataProcurarii; }
+    Data getDataActivarii() const { return dataActivarii; }
+    Data getDataExpirarii() const { return dataExpirarii; }
+
+    void procura(const Data& data) {
+        stare = PROCURAT;
+        dataProcurarii = data;
+    }
+
+    // The subscription runs for `durata` months starting on the activation day
+    void activeaza(const Data& dataA) {
+        stare = ACTIV;
+        dataActivarii = dataA;
+        dataExpirarii = dataA.adaugaLuni(durata);
+    }
+
+    void expira() { stare = EXPIRAT; }
+    bool esteActiv() const { return stare == ACTIV; }
+
+    virtual Bani calculeazaPretDiscount(double procentDiscount) const = 0;
+    virtual std::string afiseazaTip() const = 0;
+    virtual void afiseazaBeneficii(std::ostream& os) const = 0;
+    virtual Abonament* clone() const = 0;
+
+    bool operator==(const Abonament& other) const {
+        return (tip == other.tip && durata == other.durata);
+    }
+
+    bool operator>(const Abonament& other) const {
+        return pret > other.pret;
+    }
+
+    friend class Snapshot;
+
+    friend std::ostream& operator<<(std::ostream& os, const Abonament& ab) {
+        os << "Abonament " << ab.tip << " (" << ab.durata << " luni, "
+           << ab.pret << " MDL) - Stare: ";
+        switch (ab.stare) {
+            case NEPROCURAT: os << "NEPROCURAT"; break;
+            case PROCURAT:   os << "PROCURAT";   break;
+            case ACTIV:      os << "ACTIV";      break;
+            case EXPIRAT:    os << "EXPIRAT";    break;
+        }
+        return os;
+    }
+
+    virtual void afiseazaDetalii(std::ostream& os) const {
+        os << "   Tip: " << tip << '\n';
+        os << "   Durată: " << durata << " luni\n";
+        os << "   Preț: " << pret << " MDL\n";
+        os << "   Stare: ";
+        switch (stare) {
+            case NEPROCURAT: os << "NEPROCURAT"; break;
+            case PROCURAT:   os << "PROCURAT";   break;
+            case ACTIV:      os << "ACTIV";      break;
+            case EXPIRAT:    os << "EXPIRAT";    break;
+        }
+        os << '\n';
+        if (dataProcurarii.esteDefinita()) os << "   Data procurării: "  << dataProcurarii << '\n';
+        if (dataActivarii.esteDefinita())  os << "   Data activării: "   << dataActivarii  << '\n';
+        if (dataExpirarii.esteDefinita())  os << "   Data expirării: "   << dataExpirarii  << '\n';
+    }
+};
+
+class AbonamentFitness : public Abonament {
+private:
+    bool accesSauna;
+    bool accesHidroterapie;
+
+public:
+    AbonamentFitness()
+        : Abonament("Fitness", 1, 300_lei), accesSauna(true), accesHidroterapie(false) {}
+
+    AbonamentFitness(int d, Bani p)
+        : Abonament("Fitness", d, p), accesSauna(true), accesHidroterapie(false) {}
+
+    Bani calculeazaPretDiscount(double procentDiscount) const override {
+        return pret.cuDiscount(procentDiscount);
+    }
+
+    std::string afiseazaTip() const override {
+        return "AbonamentFitness - Acces complet sala";
+    }
+
+    void afiseazaBeneficii(std::ostream& os) const override {
+        os << "   + Acces complet la echipamente\n";
+        os << "   + Acces sauna\n";
+        os << "   + Consultatii cu antrenor (saptamanal)\n";
+    }
+
+    void afiseazaDetalii(std::ostream& os) const override {
+        Abonament::afiseazaDetalii(os);
+        os << "   Beneficii speciale:\n";
+        afiseazaBeneficii(os);
+    }
+
+    Abonament* clone() const override {
+        return new AbonamentFitness(*this);
+    }
+};
+
+class AbonamentPiscina : public Abonament {
+private:
+    int numarCursuriInot;
+    bool accesAquaAerobics;
+
+public:
+    AbonamentPiscina()
+        : Abonament("Piscina", 1, 250_lei), numarCursuriInot(4), accesAquaAerobics(true) {}
+
+    AbonamentPiscina(int d, Bani p)
+        : Abonament("Piscina", d, p), numarCursuriInot(4), accesAquaAerobics(true) {}
+
+    Bani calculeazaPretDiscount(double procentDiscount) const override {
+        return pret.cuDiscount(procentDiscount);
+    }
+
+    std::string afiseazaTip() const override {
+        return "AbonamentPiscina - Acces la piscina cu cursuri";
+    }
+
+    void afiseazaBeneficii(std::ostream& os) const override {
+        os << "   + Acces nelimitat la piscina\n";
+        os << "   + " << numarCursuriInot << " cursuri de inot/luna\n";
+        os << "   + Acces la aqua aerobics\n";
+    }
+
+    void afiseazaDetalii(std::ostream& os) const override {
+        Abonament::afiseazaDetalii(os);
+        os << "   Beneficii speciale:\n";
+        afiseazaBeneficii(os);
+    }
+
+    Abonament* clone() const override {
+        return new AbonamentPiscina(*this);
+    }
+};
+
+class AbonamentCombinant : public Abonament {
+private:
+    int numarCursuriInot;
+    int numarSesiuniAntrenor;
+
+public:
+    AbonamentCombinant()
+        : Abonament("Combinant", 3, 600_lei), numarCursuriInot(8), numarSesiuniAntrenor(2) {}
+
+    AbonamentCombinant(int d, Bani p)
+        : Abonament("Combinant", d, p), numarCursuriInot(8), numarSesiuniAntrenor(2) {}
+
+    Bani calculeazaPretDiscount(double procentDiscount) const override {
+        return pret - pret.procent(procentDiscount);
+    }
+
+    std::string afiseazaTip() const override {
+        return "AbonamentCombinant - Acces complet (fitness + piscina)";
+    }
+
+    void afiseazaBeneficii(std::ostream& os) const override {
+        os << "   + Acces complet sala de fitness\n";
+        os << "   + Acces nelimitat la piscina\n";
+        os << "   + " << numarCursuriInot << " cursuri de inot/luna\n";
+        os << "   + " << numarSesiuniAntrenor << " sesiuni antrenor/saptamana\n";
+        os << "   + Sauna si hidroterapie\n";
+    }
+
+    void afiseazaDetalii(std::ostream& os) const override {
+        Abonament::afiseazaDetalii(os);
+        os << "   Beneficii speciale:\n";
+        afiseazaBeneficii(os);
+    }
+
+    Abonament* clone() const override {
+        return new AbonamentCombinant(*this);
+    }
+};
+
+// Stable numeric codes of the concrete subscription types, used by the binary formats
+enum TipAbonament : uint8_t { FARA_ABONAMENT = 0, TIP_FITNESS = 1, TIP_PISCINA = 2, TIP_COMBINANT = 3 };
+
+// A subscription held by value: nothing, or one of the three concrete types,
+// stored inline. Copying it copies the object in place (no clone(), no heap),
+// while the Abonament interface stays virtual for the code that uses it.
+class AbonamentValoare {
+private:
+    using Varianta = std::variant<std::monostate, AbonamentFitness, AbonamentPiscina, AbonamentCombinant>;
+    Varianta valoare;
+
+    static_assert(std::is_same_v<std::variant_alternative_t<TIP_FITNESS, Varianta>, AbonamentFitness> &&
+                  std::is_same_v<std::variant_alternative_t<TIP_PISCINA, Varianta>, AbonamentPiscina> &&
+                  std::is_same_v<std::variant_alternative_t<TIP_COMBINANT, Varianta>, AbonamentCombinant>);
+
+public:
+    AbonamentValoare() = default;
+    AbonamentValoare(AbonamentFitness ab)   : valoare(std::move(ab)) {}
+    AbonamentValoare(AbonamentPiscina ab)   : valoare(std::move(ab)) {}
+    AbonamentValoare(AbonamentCombinant ab) : valoare(std::move(ab)) {}
+
+    // The variant alternatives are declared in TipAbonament order
+    TipAbonament tip() const { return static_cast<TipAbonament>(valoare.index()); }
+
+    Abonament* get() {
+        switch (valoare.index()) {
+            case TIP_FITNESS:   return std::get_if<AbonamentFitness>(&valoare);
+            case TIP_PISCINA:   return std::get_if<AbonamentPiscina>(&valoare);
+            case TIP_COMBINANT: return std::get_if<AbonamentCombinant>(&valoare);
+            default:            return nullptr;
+        }
+    }
+    const Abonament* get() const { return const_cast<AbonamentValoare*>(this)->get(); }
+
+    Abonament* operator->() { return get(); }
+    const Abonament* operator->() const { return get(); }
+    explicit operator bool() const { return valoare.index() != FARA_ABONAMENT; }
+};
+
+inline AbonamentValoare creeazaAbonament(TipAbonament tip, int durata, Bani pret) {
+    switch (tip) {
+        case TIP_FITNESS:   return AbonamentFitness(durata, pret);
+        case TIP_PISCINA:   return AbonamentPiscina(durata, pret);
+        case TIP_COMBINANT: return AbonamentCombinant(durata, pret);
+        default:            return AbonamentValoare();
+    }
+}
+
+// The catalog subscription with this name or menu number ("procura", the
+// server, the CSV import); empty if unknown
+inline AbonamentValoare abonamentDupaNume(std::string_view nume) {
+    if (nume == "1" || nume == "fitness")   return AbonamentFitness(1, 300_lei);
+    if (nume == "2" || nume == "piscina")   return AbonamentPiscina(1, 250_lei);
+    if (nume == "3" || nume == "combinant") return AbonamentCombinant(3, 600_lei);
+    return AbonamentValoare();
+}
+
+#endif // ABONAMENT_H
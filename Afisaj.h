@@ -0,0 +1,76 @@
+#ifndef AFISAJ_H
+#define AFISAJ_H
+
+#include <ostream>
+#include "Rezultat.h"
+
+// Turns operation results and reports into console text. Lines end in '\n'
+// and nothing is flushed here: at the console std::cin flushes std::cout
+// before every read, so each prompt still shows up in time, and batch runs put
+// a TamponIesire behind the stream. A default-constructed Afisaj is silent and
+// formats nothing at all.
+class Afisaj {
+private:
+    std::ostream* os = nullptr;
+
+public:
+    Afisaj() = default;
+    explicit Afisaj(std::ostream& os) : os(&os) {}
+
+    bool tacut() const { return os == nullptr; }
+
+    // Prints the message for `r`. Returns whether the operation succeeded.
+    bool operator()(const Rezultat& r) const {
+        if (!os) return static_cast<bool>(r);
+        std::ostream& o = *os;
+        switch (r.cod) {
+            case CodRezultat::CLIENT_INREGISTRAT: o << "Client inregistrat cu succes!\n"; break;
+            case CodRezultat::AUTENTIFICAT:       o << "Autentificare reusita! Bun venit, " << r.nume << "!\n"; break;
+            case CodRezultat::SOLD_ADAUGAT:       o << "Sold adaugat! Sold curent: " << r.sold << " MDL\n"; break;
+            case CodRezultat::SOLD_RETRAS:        o << "Suma retrasa! Sold curent: " << r.sold << " MDL\n"; break;
+            case CodRezultat::ABONAMENT_INLOCUIT:
+                o << "   Abonament vechi sters, inlocuit cu noul abonament.\n";
+                [[fallthrough]];
+            case CodRezultat::ABONAMENT_PROCURAT: o << "Abonament procurat cu succes!\n"; break;
+            case CodRezultat::ABONAMENT_ACTIVAT:
+                o << "Abonament activat cu succes!\n"
+                  << "   Valabil pana la: " << r.data << '\n'
+                  << "   Suma dedusa: " << r.suma << " MDL\n"
+                  << "   Sold ramas: "  << r.sold << " MDL\n";
+                break;
+            case CodRezultat::PAROLA_SCHIMBATA:   o << "Parola schimbata cu succes!\n"; break;
+            case CodRezultat::BONUS_APLICAT:      o << "Bonus aplicat: " << r.suma << " MDL. Sold nou: " << r.sold << '\n'; break;
+            case CodRezultat::BONUS_GRUP_APLICAT:
+                o << "Bonus de " << r.suma << " MDL aplicat la " << r.numar << " clienti.\n";
+                break;
+            case CodRezultat::DATA_AVANSATA:      o << "Abonamente expirate: " << r.numar << '\n'; break;
+            case CodRezultat::TELEFON_INVALID:
+                o << "Numar de telefon invalid! (Format: 0XXXXXXXXX sau +373XXXXXXXXX)\n";
+                break;
+            case CodRezultat::TELEFON_FOLOSIT:    o << "Telefon deja folosit!\n"; break;
+            case CodRezultat::VARSTA_INVALIDA:    o << "Varsta invalida!\n"; break;
+            case CodRezultat::CLIENT_INEXISTENT:  o << "Client inexistent!\n"; break;
+            case CodRezultat::PAROLA_INCORECTA:   o << "Parola incorecta!\n"; break;
+            case CodRezultat::SUMA_INVALIDA:      o << "Suma invalida!\n"; break;
+            case CodRezultat::SOLD_INSUFICIENT:   o << "Sold insuficient! (" << r.sold << " / " << r.suma << ")\n"; break;
+            case CodRezultat::FARA_ABONAMENT_PROCURAT: o << "Nu aveti un abonament procurat!\n"; break;
+            case CodRezultat::PAROLA_VECHE_INCORECTA:  o << "Parola veche incorecta!\n"; break;
+            case CodRezultat::DATA_IN_TRECUT:     o << "Data nu poate merge inapoi!\n"; break;
+        }
+        return static_cast<bool>(r);
+    }
+
+    // One line made of `parti`
+    template <typename... T>
+    void linie(const T&... parti) const {
+        if (os) (*os << ... << parti) << '\n';
+    }
+
+    // Runs a view, f(std::ostream&), unless silent
+    template <typename F>
+    void vedere(F&& f) const {
+        if (os) f(*os);
+    }
+};
+
+#endif // AFISAJ_H
@@ -0,0 +1,121 @@
+#ifndef BANI_H
+#define BANI_H
+
+#include <cmath>
+#include <compare>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string_view>
+#include <type_traits>
+
+// An amount of money in bani (1 MDL = 100 bani), held as a 64-bit integer.
+// Additions are exact and associative, so a total comes out the same whatever
+// the order or the number of threads that add it up. Percentages with at most
+// two decimals are applied in integers too; only finer ones go through a double.
+class Bani {
+private:
+    int64_t valoare = 0;
+
+    constexpr explicit Bani(int64_t bani) : valoare(bani) {}
+
+public:
+    constexpr Bani() = default;
+
+    static constexpr Bani dinBani(int64_t bani) { return Bani(bani); }
+    static constexpr Bani dinLei(int64_t lei) { return Bani(lei * 100); }
+    // Nearest ban, halves away from zero
+    static Bani rotunjit(double lei) { return Bani(std::llround(lei * 100.0)); }
+
+    // "[+-]lei[.bani]" with at most two decimals ('.' or ','), exactly, without a double
+    static constexpr bool parseaza(std::string_view text, Bani& rezultat) {
+        size_t i = 0;
+        bool negativ = false;
+        if (i < text.size() && (text[i] == '+' || text[i] == '-')) negativ = text[i++] == '-';
+        int64_t lei = 0, bani = 0;
+        int cifre = 0, zecimale = 0;
+        for (; i < text.size() && text[i] >= '0' && text[i] <= '9'; i++) {
+            if (++cifre > 15) return false;
+            lei = lei * 10 + (text[i] - '0');
+        }
+        if (i < text.size() && (text[i] == '.' || text[i] == ',')) {
+            for (i++; i < text.size() && text[i] >= '0' && text[i] <= '9'; i++) {
+                if (++zecimale > 2) return false;
+                bani = bani * 10 + (text[i] - '0');
+            }
+            if (zecimale == 1) bani *= 10;
+        }
+        if (i != text.size() || cifre + zecimale == 0) return false;
+        rezultat = Bani(negativ ? -(lei * 100 + bani) : lei * 100 + bani);
+        return true;
+    }
+
+    constexpr int64_t bani() const { return valoare; }
+
+    // `procent` in hundredths of a percent (12.5 -> 1250), if it has at most two decimals
+    static bool sutimiDeProcent(double procent, int64_t& sutimi) {
+        const double x = procent * 100.0;
+        if (!(std::fabs(x) <= 1e9)) return false;
+        sutimi = std::llround(x);
+        return std::fabs(x - static_cast<double>(sutimi)) < 1e-6;
+    }
+
+    // sutimi / 100 percent of `bani`, to the nearest ban, halves away from zero:
+    // (|bani| * |sutimi| + 5000) / 10000 with the sign put back. Exact while
+    // |bani| * |sutimi| stays below 2^63 (9 * 10^14 bani at 100%).
+    static constexpr int64_t procentDin(int64_t bani, int64_t sutimi) {
+        const uint64_t modul = (bani < 0 ? 0 - static_cast<uint64_t>(bani) : static_cast<uint64_t>(bani)) *
+                               (sutimi < 0 ? 0 - static_cast<uint64_t>(sutimi) : static_cast<uint64_t>(sutimi));
+        const int64_t cat = static_cast<int64_t>((modul + 5000) / 10000);
+        return (bani < 0) != (sutimi < 0) ? -cat : cat;
+    }
+
+    // `procent` percent of this amount, rounded to the nearest ban
+    Bani procent(double procent) const {
+        int64_t sutimi;
+        if (sutimiDeProcent(procent, sutimi)) return Bani(procentDin(valoare, sutimi));
+        return Bani(std::llround(static_cast<double>(valoare) * (procent / 100.0)));
+    }
+    Bani cuDiscount(double procent) const { return *this - this->procent(procent); }
+
+    constexpr Bani operator+(Bani b) const { return Bani(valoare + b.valoare); }
+    constexpr Bani operator-(Bani b) const { return Bani(valoare - b.valoare); }
+    constexpr Bani operator-() const { return Bani(-valoare); }
+    constexpr Bani operator*(int64_t n) const { return Bani(valoare * n); }
+    constexpr Bani& operator+=(Bani b) { valoare += b.valoare; return *this; }
+    constexpr Bani& operator-=(Bani b) { valoare -= b.valoare; return *this; }
+    constexpr auto operator<=>(const Bani&) const = default;
+
+    // Whole lei without decimals ("300"), otherwise two ("12.50")
+    friend std::ostream& operator<<(std::ostream& os, Bani b) {
+        uint64_t modul = b.valoare < 0 ? 0 - static_cast<uint64_t>(b.valoare) : static_cast<uint64_t>(b.valoare);
+        const char* semn = b.valoare < 0 ? "-" : "";
+        char text[32];
+        if (modul % 100 == 0)
+            std::snprintf(text, sizeof(text), "%s%llu", semn, static_cast<unsigned long long>(modul / 100));
+        else
+            std::snprintf(text, sizeof(text), "%s%llu.%02llu", semn, static_cast<unsigned long long>(modul / 100),
+                          static_cast<unsigned long long>(modul % 100));
+        return os << text;
+    }
+};
+
+// The columnar kernels load and store balances as raw 64-bit lanes
+static_assert(sizeof(Bani) == sizeof(int64_t) && std::is_trivially_copyable_v<Bani>);
+
+constexpr Bani operator""_lei(unsigned long long lei) { return Bani::dinLei(static_cast<int64_t>(lei)); }
+constexpr Bani operator""_bani(unsigned long long bani) { return Bani::dinBani(static_cast<int64_t>(bani)); }
+
+namespace detaliiBani {
+constexpr Bani parsat(std::string_view text) {
+    Bani b = Bani::dinBani(-1);
+    Bani::parseaza(text, b);
+    return b;
+}
+}
+static_assert(detaliiBani::parsat("12.5") == 1250_bani && detaliiBani::parsat("0,05") == 5_bani);
+static_assert(detaliiBani::parsat("-3") == -300_bani && detaliiBani::parsat("300") == 300_lei);
+static_assert(detaliiBani::parsat("1.234") == -1_bani && detaliiBani::parsat("1e3") == -1_bani);
+static_assert(Bani::procentDin(50, 2900) == 15 && Bani::procentDin(-50, 2900) == -15 && Bani::procentDin(1999, 1250) == 250);
+
+#endif // BANI_H
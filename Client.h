@@ -0,0 +1,138 @@
+#ifndef CLIENT_H
+#define CLIENT_H
+
+#include <iostream>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include "Abonament.h"
+#include "Bani.h"
+#include "Data.h"
+#include "Metrici.h"
+#include "Rezultat.h"
+
+class Client {
+private:
+    // Allocated from the memory resource given at construction (the Sala's pool
+    // for registered clients); copies of a client use the default heap
+    std::pmr::string nume;
+    std::pmr::string telefon;
+    std::pmr::string parola;
+    int varsta;
+    Bani sold;
+    AbonamentValoare abonament;   // inline, copied with the client
+
+public:
+    // Default constructor
+    Client()
+        : nume(""), telefon(""), parola(""), varsta(0), sold() {}
+
+    // The strings are copied once, straight into `memorie`
+    Client(std::string_view n, std::string_view t, std::string_view p, int v,
+           std::pmr::memory_resource* memorie = std::pmr::get_default_resource())
+        : nume(n, memorie), telefon(t, memorie), parola(p, memorie), varsta(v), sold() {}
+
+    // The subscription is a value member, so the implicit copy operations
+    // already copy it deeply. A moved-to client keeps the source's memory
+    // resource, which must outlive it.
+    Client(const Client& other) = default;
+    Client(Client&& other) noexcept = default;
+    Client& operator=(const Client& other) = default;
+    Client& operator=(Client&& other) = default;
+    ~Client() = default;
+
+    std::string getNume()    const { return std::string(nume); }
+    std::string getTelefon() const { return std::string(telefon); }
+    int    getVarsta()  const { return varsta; }
+    Bani   getSold()    const { return sold; }
+    const Abonament* getAbonament() const { return abonament.get(); }
+    TipAbonament getTipAbonament() const { return abonament.tip(); }
+
+    Rezultat adaugaSold(Bani suma) {
+        CronometruOperatie cronometru(Operatie::CLIENT_ADAUGA_SOLD);
+        if (suma <= Bani()) return CodRezultat::SUMA_INVALIDA;
+        sold += suma;
+        Rezultat r(CodRezultat::SOLD_ADAUGAT);
+        r.suma = suma;
+        r.sold = sold;
+        return r;
+    }
+
+    Rezultat procuraAbonament(AbonamentValoare ab, const Data& data) {
+        CronometruOperatie cronometru(Operatie::CLIENT_PROCURARE);
+        bool inlocuit = static_cast<bool>(abonament);
+        abonament = std::move(ab);
+        abonament->procura(data);
+        return inlocuit ? CodRezultat::ABONAMENT_INLOCUIT : CodRezultat::ABONAMENT_PROCURAT;
+    }
+
+    Rezultat activeazaAbonament(const Data& dataA) {
+        CronometruOperatie cronometru(Operatie::CLIENT_ACTIVARE);
+        if (!abonament || abonament->getStare() != PROCURAT) return CodRezultat::FARA_ABONAMENT_PROCURAT;
+
+        Rezultat r(CodRezultat::SOLD_INSUFICIENT);
+        r.suma = abonament->getPret();
+        if (sold >= r.suma) {
+            sold -= r.suma;
+            abonament->activeaza(dataA);
+            r.cod  = CodRezultat::ABONAMENT_ACTIVAT;
+            r.data = abonament->getDataExpirarii();
+        }
+        r.sold = sold;
+        return r;
+    }
+
+    bool verificaParola(std::string_view p) const {
+        CronometruOperatie cronometru(Operatie::CLIENT_VERIFICA_PAROLA);
+        return std::string_view(parola) == p;
+    }
+
+    Rezultat schimbaParola(const std::string& parolaVeche, const std::string& parolaNoua) {
+        CronometruOperatie cronometru(Operatie::CLIENT_PAROLA);
+        if (!verificaParola(parolaVeche)) return CodRezultat::PAROLA_VECHE_INCORECTA;
+        parola = parolaNoua;
+        return CodRezultat::PAROLA_SCHIMBATA;
+    }
+
+    Client& operator+=(Bani suma) {
+        if (suma > Bani()) sold += suma;
+        return *this;
+    }
+
+    Client& operator-=(Bani suma) {
+        if (suma > Bani() && suma <= sold) sold -= suma;
+        return *this;
+    }
+
+    bool operator<(const Client& other) const { return varsta < other.varsta; }
+    bool operator==(const Client& other) const { return telefon == other.telefon; }
+
+    friend std::ostream& operator<<(std::ostream& os, const Client& c) {
+        os << c.nume << " (" << c.telefon << ") - " << c.varsta
+           << " ani, Sold: " << c.sold << " MDL";
+        return os;
+    }
+
+    void afiseazaProfil(std::ostream& os) const {
+        CronometruOperatie cronometru(Operatie::CLIENT_PROFIL);
+        os << "\n========== PROFIL CLIENT ==========\n"
+           << "Nume: "    << nume    << '\n'
+           << "Telefon: " << telefon << '\n'
+           << "Varsta: "  << varsta  << " ani\n"
+           << "Sold: "    << sold    << " MDL\n"
+           << "\nDetalii Abonament:\n";
+        if (abonament) {
+            abonament->afiseazaDetalii(os);
+        } else {
+            os << "   Niciun abonament activ!\n";
+        }
+        os << "===================================\n";
+    }
+
+    friend class Sala;
+    friend class Snapshot;
+    friend class ImportClienti;
+    friend class ExportAnalitic;
+};
+
+#endif // CLIENT_H
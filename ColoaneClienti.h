@@ -0,0 +1,190 @@
+#ifndef COLOANECLIENTI_H
+#define COLOANECLIENTI_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Abonament.h"
+#include "Bani.h"
+#include "Client.h"
+#include "Data.h"
+#include "Vectorial.h"
+
+// Which clients an aggregate counts: inclusive ranges on the subscription type,
+// its state and the age. -1 leaves tip/stare unrestricted, so
+// FiltruClienti{.tip = TIP_COMBINANT, .stare = ACTIV, .varstaMin = 30}
+// selects the active Combinant members aged 30 or more.
+struct FiltruClienti {
+    int tip = -1;
+    int stare = -1;
+    int varstaMin = 0;
+    int varstaMax = 255;
+};
+
+// Struct-of-arrays copy of the numeric client fields, kept by Sala in step
+// with its clients: element i of every column describes clienti[i].
+// A scan reads only the columns it needs (11 bytes per client for a balance
+// total instead of a whole Client) and the loops are branch-free, so the
+// compiler can vectorize them. Money columns are integer bani, so sums are
+// exact in any order.
+class ColoaneClienti {
+private:
+    std::vector<uint8_t> varsta;
+    std::vector<uint8_t> tip;      // TipAbonament
+    std::vector<uint8_t> stare;    // StareAbonament (NEPROCURAT without a subscription)
+    std::vector<Bani> sold;
+    std::vector<Bani> pret;        // subscription price, 0 without one
+    std::vector<int32_t> expirare; // Data::zile(), NEDEFINITA unless activated
+
+    // Bounds of a filter, as unsigned ranges [jos, jos + latime]
+    struct Intervale {
+        uint8_t tipJos, tipLatime, stareJos, stareLatime, varstaJos, varstaLatime;
+        bool gol = false;   // some range is empty: nothing matches
+
+        explicit Intervale(const FiltruClienti& f) {
+            interval(f.tip < 0 ? 0 : f.tip, f.tip < 0 ? 255 : f.tip, tipJos, tipLatime);
+            interval(f.stare < 0 ? 0 : f.stare, f.stare < 0 ? 255 : f.stare, stareJos, stareLatime);
+            interval(f.varstaMin, f.varstaMax, varstaJos, varstaLatime);
+        }
+
+        void interval(int jos, int sus, uint8_t& inceput, uint8_t& latime) {
+            jos = jos < 0 ? 0 : jos;
+            sus = sus > 255 ? 255 : sus;
+            if (sus < jos) gol = true;
+            inceput = static_cast<uint8_t>(jos);
+            latime = static_cast<uint8_t>(sus - jos);
+        }
+
+        // One unsigned comparison per column: (x - jos) wraps around when x < jos
+        bool potriveste(uint8_t t, uint8_t s, uint8_t v) const {
+            return (static_cast<uint8_t>(t - tipJos) <= tipLatime) &
+                   (static_cast<uint8_t>(s - stareJos) <= stareLatime) &
+                   (static_cast<uint8_t>(v - varstaJos) <= varstaLatime);
+        }
+
+#if defined(FITZONE_SIMD)
+        // The same test for LATIME_SIMD clients, widened to one 64-bit lane per client
+        VectorMasca potrivesteVector(const uint8_t* t, const uint8_t* s, const uint8_t* v) const {
+            auto m = (incarcaOcteti(t) - tipJos <= tipLatime) & (incarcaOcteti(s) - stareJos <= stareLatime) &
+                     (incarcaOcteti(v) - varstaJos <= varstaLatime);
+            return __builtin_convertvector(m, VectorMasca);
+        }
+#endif
+    };
+
+    void scrie(size_t i, const Client& c) {
+        const Abonament* ab = c.getAbonament();
+        varsta[i]   = static_cast<uint8_t>(c.getVarsta());
+        tip[i]      = c.getTipAbonament();
+        stare[i]    = static_cast<uint8_t>(ab ? ab->getStare() : NEPROCURAT);
+        sold[i]     = c.getSold();
+        pret[i]     = ab ? ab->getPret() : Bani();
+        expirare[i] = ab ? ab->getDataExpirarii().zile() : Data().zile();
+    }
+
+public:
+    size_t dimensiune() const { return sold.size(); }
+
+    void adauga(const Client& c) {
+        varsta.emplace_back();
+        tip.emplace_back();
+        stare.emplace_back();
+        sold.emplace_back();
+        pret.emplace_back();
+        expirare.emplace_back();
+        scrie(sold.size() - 1, c);
+    }
+
+    void actualizeaza(size_t i, const Client& c) { scrie(i, c); }
+
+    const uint8_t* getVarste() const { return varsta.data(); }
+    const uint8_t* getTipuri() const { return tip.data(); }
+    const uint8_t* getStari() const { return stare.data(); }
+    const Bani* getSolduri() const { return sold.data(); }
+    const Bani* getPreturi() const { return pret.data(); }
+    const int32_t* getExpirari() const { return expirare.data(); }
+
+    size_t numara(const FiltruClienti& f) const {
+        Intervale in(f);
+        if (in.gol) return 0;
+        size_t n = sold.size(), total = 0;
+        const uint8_t *t = tip.data(), *s = stare.data(), *v = varsta.data();
+        for (size_t i = 0; i < n; i++) total += in.potriveste(t[i], s[i], v[i]);
+        return total;
+    }
+
+    Bani soldTotal(const FiltruClienti& f) const {
+        Intervale in(f);
+        if (in.gol) return Bani();
+        size_t n = sold.size(), i = 0;
+        const uint8_t *t = tip.data(), *s = stare.data(), *v = varsta.data();
+        const Bani* b = sold.data();
+        Bani suma;
+#if defined(FITZONE_SIMD)
+        VectorIntreg partiale = {};
+        for (; i + LATIME_SIMD <= n; i += LATIME_SIMD)
+            partiale += selecteaza(in.potrivesteVector(t + i, s + i, v + i), incarcaVector(b + i));
+        suma = Bani::dinBani(sumaBenzi(partiale));
+#endif
+        for (; i < n; i++) suma += in.potriveste(t[i], s[i], v[i]) ? b[i] : Bani();
+        return suma;
+    }
+
+    // Calls f(i) for every matching client, in order
+    template <typename F>
+    void pentruFiecare(const FiltruClienti& f, F&& functie) const {
+        Intervale in(f);
+        if (in.gol) return;
+        for (size_t i = 0; i < sold.size(); i++)
+            if (in.potriveste(tip[i], stare[i], varsta[i])) functie(i);
+    }
+
+    // Adds `suma` to the balance column of every matching client, one vector
+    // of clients per step. Returns how many matched. The caller copies the new balances
+    // back into the Client objects.
+    size_t aplicaBonus(const FiltruClienti& f, Bani suma) {
+        Intervale in(f);
+        if (in.gol) return 0;
+        size_t n = sold.size(), i = 0, potrivite = 0;
+        const uint8_t *t = tip.data(), *s = stare.data(), *v = varsta.data();
+        Bani* b = sold.data();
+#if defined(FITZONE_SIMD)
+        const VectorIntreg bonus = VectorIntreg{} + suma.bani();
+        VectorMasca numar = {};
+        for (; i + LATIME_SIMD <= n; i += LATIME_SIMD) {
+            VectorMasca m = in.potrivesteVector(t + i, s + i, v + i);
+            stocheazaVector(b + i, incarcaVector(b + i) + selecteaza(m, bonus));
+            numar -= m;   // a set lane is -1
+        }
+        potrivite = static_cast<size_t>(sumaBenzi(numar));
+#endif
+        for (; i < n; i++) {
+            bool m = in.potriveste(t[i], s[i], v[i]);
+            b[i] += m ? suma : Bani();
+            potrivite += m;
+        }
+        return potrivite;
+    }
+
+    // rezultat[i] = subscription price of client i with `procent` off, or 0
+    // outside the segment. Returns the sum over the segment.
+    // Each price is rounded to the nearest ban exactly like
+    // Abonament::calculeazaPretDiscount. A percentage with at most two decimals
+    // is applied in integers (Bani::procentDin): one multiply and one division
+    // by a constant per client. The loop stays scalar on purpose: SSE2 and AVX2
+    // have no 64-bit multiply, and emulating it in vector lanes measured 3-8x
+    // slower than this loop.
+    Bani preturiCuDiscount(const FiltruClienti& f, double procent, Bani* rezultat) const {
+        Intervale in(f);
+        size_t n = pret.size();
+        const uint8_t *t = tip.data(), *s = stare.data(), *v = varsta.data();
+        Bani total;
+        for (size_t i = 0; i < n; i++) {
+            rezultat[i] = !in.gol && in.potriveste(t[i], s[i], v[i]) ? pret[i].cuDiscount(procent) : Bani();
+            total += rezultat[i];
+        }
+        return total;
+    }
+};
+
+#endif // COLOANECLIENTI_H
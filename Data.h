@@ -0,0 +1,114 @@
+#ifndef DATA_H
+#define DATA_H
+
+#include <compare>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include "Validare.h"
+
+// Calendar date stored as a 4-byte day number (days since 1970-01-01).
+// Comparing two dates is an integer compare; conversions to and from
+// year/month/day use the closed-form civil calendar formulas.
+class Data {
+private:
+    static constexpr int32_t NEDEFINITA = INT32_MIN;
+    int32_t zi;
+
+    explicit constexpr Data(int32_t zileDeLaEpoca) : zi(zileDeLaEpoca) {}
+
+public:
+    // An unset date (e.g. a subscription that was never activated)
+    constexpr Data() : zi(NEDEFINITA) {}
+
+    static constexpr Data dinZile(int32_t zileDeLaEpoca) { return Data(zileDeLaEpoca); }
+
+    // Expects a valid calendar day
+    static constexpr Data dinCalendar(int an, int luna, int ziLuna) {
+        an -= luna <= 2;
+        const int era = (an >= 0 ? an : an - 399) / 400;
+        const int anEra = an - era * 400;
+        const int ziAn = (153 * (luna + (luna > 2 ? -3 : 9)) + 2) / 5 + ziLuna - 1;
+        const int ziEra = anEra * 365 + anEra / 4 - anEra / 100 + ziAn;
+        return Data(era * 146097 + ziEra - 719468);
+    }
+
+    // Parses "YYYY-MM-DD"; returns false for malformed or non-existent days
+    static constexpr bool parseaza(std::string_view text, Data& rezultat) {
+        int an = 0, luna = 0, ziLuna = 0;
+        if (!parseazaData(text, an, luna, ziLuna)) return false;
+        rezultat = dinCalendar(an, luna, ziLuna);
+        return true;
+    }
+
+    constexpr void inCalendar(int& an, int& luna, int& ziLuna) const {
+        const int z = zi + 719468;
+        const int era = (z >= 0 ? z : z - 146096) / 146097;
+        const int ziEra = z - era * 146097;
+        const int anEra = (ziEra - ziEra / 1460 + ziEra / 36524 - ziEra / 146096) / 365;
+        const int ziAn = ziEra - (365 * anEra + anEra / 4 - anEra / 100);
+        const int lunaMartie = (5 * ziAn + 2) / 153;
+        ziLuna = ziAn - (153 * lunaMartie + 2) / 5 + 1;
+        luna = lunaMartie < 10 ? lunaMartie + 3 : lunaMartie - 9;
+        an = anEra + era * 400 + (luna <= 2);
+    }
+
+    constexpr bool esteDefinita() const { return zi != NEDEFINITA; }
+    constexpr int32_t zile() const { return zi; }
+
+    // Same day of the month n months later, clamped to the month's last day
+    // (2024-01-31 + 1 month = 2024-02-29)
+    constexpr Data adaugaLuni(int luni) const {
+        int an = 0, luna = 0, ziLuna = 0;
+        inCalendar(an, luna, ziLuna);
+        int total = an * 12 + (luna - 1) + luni;
+        an = total / 12;
+        luna = total % 12 + 1;
+        if (ziLuna > zileInLuna(an, luna)) ziLuna = zileInLuna(an, luna);
+        return dinCalendar(an, luna, ziLuna);
+    }
+
+    constexpr Data operator+(int zile) const { return Data(zi + zile); }
+    constexpr int operator-(const Data& other) const { return zi - other.zi; }
+
+    constexpr bool operator==(const Data& other) const = default;
+    constexpr auto operator<=>(const Data& other) const = default;
+
+    // Writes "YYYY-MM-DD" into buf (at least 10 chars), no terminator
+    void scrie(char* buf) const {
+        int an = 0, luna = 0, ziLuna = 0;
+        inCalendar(an, luna, ziLuna);
+        buf[0] = static_cast<char>('0' + an / 1000 % 10);
+        buf[1] = static_cast<char>('0' + an / 100 % 10);
+        buf[2] = static_cast<char>('0' + an / 10 % 10);
+        buf[3] = static_cast<char>('0' + an % 10);
+        buf[4] = '-';
+        buf[5] = static_cast<char>('0' + luna / 10);
+        buf[6] = static_cast<char>('0' + luna % 10);
+        buf[7] = '-';
+        buf[8] = static_cast<char>('0' + ziLuna / 10);
+        buf[9] = static_cast<char>('0' + ziLuna % 10);
+    }
+
+    std::string text() const {
+        if (!esteDefinita()) return "";
+        char buf[10];
+        scrie(buf);
+        return std::string(buf, 10);
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const Data& d) {
+        if (!d.esteDefinita()) return os << "-";
+        char buf[10];
+        d.scrie(buf);
+        return os.write(buf, 10);
+    }
+};
+
+static_assert(sizeof(Data) == 4);
+static_assert(Data::dinCalendar(1970, 1, 1).zile() == 0);
+static_assert(Data::dinCalendar(2024, 1, 31).adaugaLuni(1) == Data::dinCalendar(2024, 2, 29));
+static_assert(Data::dinCalendar(2025, 11, 15).adaugaLuni(3) == Data::dinCalendar(2026, 2, 15));
+
+#endif // DATA_H
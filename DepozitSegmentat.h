@@ -0,0 +1,64 @@
+#ifndef DEPOZITSEGMENTAT_H
+#define DEPOZITSEGMENTAT_H
+
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+// Growable storage that never relocates its elements.
+// Segment s holds (2^s * PRIMUL) elements, so the directory is a fixed array
+// and any index maps to (segment, offset) with a couple of bit operations.
+// A segment is allocated only when the previous one is full, and elements are
+// constructed in place one by one, so unused slots are never constructed.
+template <typename T, unsigned LOG_PRIMUL = 10>
+class DepozitSegmentat {
+private:
+    static constexpr size_t PRIMUL = size_t(1) << LOG_PRIMUL;
+    static constexpr unsigned MAX_SEGMENTE = 48;
+
+    T* segmente[MAX_SEGMENTE] = {};
+    size_t numar = 0;
+
+    static unsigned segment(size_t i) {
+        return static_cast<unsigned>(std::bit_width((i >> LOG_PRIMUL) + 1)) - 1;
+    }
+    static size_t inceput(unsigned s) { return ((size_t(1) << s) - 1) << LOG_PRIMUL; }
+    static size_t marime(unsigned s)  { return PRIMUL << s; }
+
+public:
+    DepozitSegmentat() = default;
+    DepozitSegmentat(const DepozitSegmentat&) = delete;
+    DepozitSegmentat& operator=(const DepozitSegmentat&) = delete;
+
+    ~DepozitSegmentat() {
+        for (size_t i = 0; i < numar; i++) (*this)[i].~T();
+        std::allocator<T> alocator;
+        for (unsigned s = 0; s < MAX_SEGMENTE && segmente[s]; s++)
+            alocator.deallocate(segmente[s], marime(s));
+    }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        unsigned s = segment(numar);
+        if (!segmente[s]) segmente[s] = std::allocator<T>().allocate(marime(s));
+        T* loc = segmente[s] + (numar - inceput(s));
+        ::new (static_cast<void*>(loc)) T(std::forward<Args>(args)...);
+        numar++;
+        return *loc;
+    }
+
+    T& operator[](size_t i) {
+        unsigned s = segment(i);
+        return segmente[s][i - inceput(s)];
+    }
+    const T& operator[](size_t i) const {
+        unsigned s = segment(i);
+        return segmente[s][i - inceput(s)];
+    }
+
+    size_t size() const { return numar; }
+    bool empty() const { return numar == 0; }
+};
+
+#endif // DEPOZITSEGMENTAT_H
@@ -0,0 +1,541 @@
+#ifndef EXPORTANALITIC_H
+#define EXPORTANALITIC_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Abonament.h"
+#include "Bani.h"
+#include "Client.h"
+#include "Data.h"
+#include "FisierMapat.h"
+#include "Sala.h"
+
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
+
+struct OptiuniExport {
+    uint32_t randuriPeGrup = 65536;
+    // Varints, date deltas and run-length codes; without it every number is
+    // fixed-width, which is larger but can be loaded with a plain copy
+    bool compresie = true;
+};
+
+// One member as read back from an export file
+struct RandExport {
+    std::string_view nume, telefon;
+    int varsta = 0;
+    Bani sold;
+    TipAbonament tip = FARA_ABONAMENT;
+    StareAbonament stare = NEPROCURAT;
+    Bani pret;
+    int durata = 0;
+    Data procurare, activare, expirare;   // unset without a subscription
+};
+
+// Columnar export of the members for offline analytics. Passwords are not exported.
+//
+// Layout (native little-endian):
+//   Antet     magic "FZCOLS", u32 versiune, u32 randuriPeGrup
+//   Grup*     randuriPeGrup members each (the last one fewer), in registration order
+//   Subsol    u64 offset of every group, u64 numarRanduri, u32 numarGrupuri,
+//             u32 rezervat, magic "FZCOLEND"
+//
+// Grup: u32 marime (bytes after this field), u32 numarRanduri, u64 sumaControl
+// (FNV-1a of the blocks), then one block per column, in Coloana order:
+// u8 coloana, u8 Codare, u32 lungime, the encoded values.
+//
+// Subscription type and state are dictionary-encoded: each block starts with the
+// names of the values present in it (u8 count, then u8 length + name each), and
+// the values are codes into that list.
+//
+// The exporter never holds more than one group in memory: it copies a group's
+// members under the gym's exclusive lock, releases it, then encodes and writes
+// the group, so the desks are blocked for one group at a time. The export covers
+// the members registered when it started. The file is written to a temporary and
+// renamed, as the snapshot is.
+class ExportAnalitic {
+public:
+    static constexpr uint32_t VERSIUNE = 1;
+
+    enum Coloana : uint8_t {
+        NUME, TELEFON, VARSTA, SOLD, TIP, STARE, PRET, DURATA,
+        DATA_PROCURARII, DATA_ACTIVARII, DATA_EXPIRARII, NUMAR_COLOANE
+    };
+
+    enum Codare : uint8_t {
+        SIRURI,          // varint length of every value, then the bytes back to back
+        FIX,             // the values at their natural width (u8 age, i64 bani, i32 months or days; INT32_MIN: unset)
+        VARINT,          // zigzag LEB128
+        DELTA,           // presence bitmap, then zigzag varint differences between present values
+        DICTIONAR,       // dictionary, u8 bits per code, codes packed from the low bit
+        DICTIONAR_RLE    // dictionary, then (u8 code, varint run length) pairs
+    };
+
+    static bool scrie(const Sala& sala, const std::string& cale, OptiuniExport optiuni = OptiuniExport()) {
+        if (optiuni.randuriPeGrup == 0) return false;
+        const size_t n = static_cast<size_t>(sala.getNumarClienti());
+
+        const std::string temporar = cale + ".tmp";
+        FILE* f = std::fopen(temporar.c_str(), "wb");
+        if (!f) return false;
+        std::string tampon;
+        scrieValoare(tampon, MAGIC);
+        scrieValoare(tampon, VERSIUNE);
+        scrieValoare(tampon, optiuni.randuriPeGrup);
+        bool ok = std::fwrite(tampon.data(), 1, tampon.size(), f) == tampon.size();
+        uint64_t pozitie = tampon.size();
+
+        Grup grup;
+        std::vector<uint64_t> offseturi;
+        for (size_t inceput = 0; ok && inceput < n; inceput += optiuni.randuriPeGrup) {
+            const size_t sfarsit = std::min(n, inceput + optiuni.randuriPeGrup);
+            {
+                std::unique_lock<std::shared_mutex> blocare(sala.structura);
+                grup.copiaza(sala, inceput, sfarsit);
+            }
+            tampon.clear();
+            grup.codifica(tampon, optiuni.compresie);
+            ok = std::fwrite(tampon.data(), 1, tampon.size(), f) == tampon.size();
+            offseturi.push_back(pozitie);
+            pozitie += tampon.size();
+        }
+
+        tampon.clear();
+        for (uint64_t o : offseturi) scrieValoare(tampon, o);
+        scrieValoare(tampon, static_cast<uint64_t>(n));
+        scrieValoare(tampon, static_cast<uint32_t>(offseturi.size()));
+        scrieValoare(tampon, uint32_t(0));
+        scrieValoare(tampon, MAGIC_SUBSOL);
+        ok = ok && std::fwrite(tampon.data(), 1, tampon.size(), f) == tampon.size() && std::fflush(f) == 0;
+#if !defined(_WIN32)
+        ok = ok && ::fsync(::fileno(f)) == 0;
+#endif
+        ok = std::fclose(f) == 0 && ok;
+        if (!ok || std::rename(temporar.c_str(), cale.c_str()) != 0) {
+            std::remove(temporar.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    // Calls peRand(const RandExport&) for every member, in order. Returns false if
+    // the file is missing, from an unknown version or damaged; each group is checked
+    // before any of its rows is passed on, so rows of earlier groups may have been.
+    template <typename F>
+    static bool citeste(const std::string& cale, F&& peRand) {
+        FisierMapat fisier(cale);
+        const size_t marimeAntet = sizeof(MAGIC) + 2 * sizeof(uint32_t);
+        const size_t marimeSubsol = sizeof(uint64_t) + 2 * sizeof(uint32_t) + sizeof(MAGIC_SUBSOL);
+        if (!fisier.date || fisier.marime < marimeAntet + marimeSubsol) return false;
+
+        Cursor antet{fisier.date, fisier.date + marimeAntet};
+        Cursor subsol{fisier.date + fisier.marime - marimeSubsol, fisier.date + fisier.marime};
+        std::array<char, 8> magic;
+        uint32_t versiune = 0, randuriPeGrup = 0, numarGrupuri = 0, rezervat = 0;
+        uint64_t numarRanduri = 0;
+        if (!antet.citeste(magic) || magic != MAGIC || !antet.citeste(versiune) || versiune != VERSIUNE ||
+            !antet.citeste(randuriPeGrup) || !subsol.citeste(numarRanduri) || !subsol.citeste(numarGrupuri) ||
+            !subsol.citeste(rezervat) || !subsol.citeste(magic) || magic != MAGIC_SUBSOL)
+            return false;
+        if (numarGrupuri > (fisier.marime - marimeAntet - marimeSubsol) / sizeof(uint64_t)) return false;
+
+        const char* zonaOffseturi = fisier.date + fisier.marime - marimeSubsol - numarGrupuri * sizeof(uint64_t);
+        Cursor offseturi{zonaOffseturi, zonaOffseturi + numarGrupuri * sizeof(uint64_t)};
+        Grup grup;
+        uint64_t citite = 0;
+        for (uint32_t g = 0; g < numarGrupuri; g++) {
+            uint64_t offset = 0;
+            if (!offseturi.citeste(offset) || offset < marimeAntet ||
+                offset > static_cast<uint64_t>(zonaOffseturi - fisier.date))
+                return false;
+            Cursor c{fisier.date + offset, zonaOffseturi};
+            if (!grup.decodifica(c, randuriPeGrup)) return false;
+            for (size_t i = 0; i < grup.numar; i++) peRand(grup.rand(i));
+            citite += grup.numar;
+        }
+        return citite == numarRanduri;
+    }
+
+private:
+    static constexpr std::array<char, 8> MAGIC = {'F', 'Z', 'C', 'O', 'L', 'S', '\0', '\0'};
+    static constexpr std::array<char, 8> MAGIC_SUBSOL = {'F', 'Z', 'C', 'O', 'L', 'E', 'N', 'D'};
+    static constexpr uint64_t BAZA_SUMA = 14695981039346656037ull;
+    static constexpr const char* NUME_TIP[] = {"fara", "fitness", "piscina", "combinant"};
+    static constexpr const char* NUME_STARE[] = {"neprocurat", "procurat", "activ", "expirat"};
+
+    template <typename T>
+    static void scrieValoare(std::string& out, const T& valoare) {
+        out.append(reinterpret_cast<const char*>(&valoare), sizeof(valoare));
+    }
+
+    static void scrieVarint(std::string& out, uint64_t v) {
+        while (v >= 0x80) {
+            out += static_cast<char>(v | 0x80);
+            v >>= 7;
+        }
+        out += static_cast<char>(v);
+    }
+
+    static uint64_t zigzag(int64_t v) { return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63); }
+    static int64_t dinZigzag(uint64_t v) { return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1); }
+
+    static uint64_t sumaControl(const char* p, size_t n) {
+        uint64_t h = BAZA_SUMA;
+        for (size_t i = 0; i < n; i++) h = (h ^ static_cast<unsigned char>(p[i])) * 1099511628211ull;
+        return h;
+    }
+
+    // Bounds-checked reads; every method returns false past the end
+    struct Cursor {
+        const char* p;
+        const char* sfarsit;
+
+        template <typename T>
+        bool citeste(T& valoare) {
+            if (static_cast<size_t>(sfarsit - p) < sizeof(T)) return false;
+            std::memcpy(&valoare, p, sizeof(T));
+            p += sizeof(T);
+            return true;
+        }
+
+        bool citesteVarint(uint64_t& v) {
+            v = 0;
+            for (int deplasare = 0; deplasare < 64; deplasare += 7) {
+                if (p == sfarsit) return false;
+                uint8_t b = static_cast<uint8_t>(*p++);
+                v |= static_cast<uint64_t>(b & 0x7F) << deplasare;
+                if (!(b & 0x80)) return true;
+            }
+            return false;
+        }
+
+        bool citesteOcteti(size_t n, std::string_view& text) {
+            if (static_cast<size_t>(sfarsit - p) < n) return false;
+            text = std::string_view(p, n);
+            p += n;
+            return true;
+        }
+    };
+
+    // One group of members, column by column
+    struct Grup {
+        size_t numar = 0;
+        std::vector<uint32_t> lungimeNume, lungimeTelefon;
+        std::string nume, telefon;                   // the values back to back
+        std::vector<uint8_t> varsta, tip, stare;
+        std::vector<int64_t> sold, pret;
+        std::vector<int32_t> durata, procurare, activare, expirare;
+        std::vector<uint32_t> inceputNume, inceputTelefon;   // filled when decoding
+
+        void redimensioneaza(size_t n) {
+            numar = n;
+            for (auto* v : {&lungimeNume, &lungimeTelefon}) v->resize(n);
+            for (auto* v : {&varsta, &tip, &stare}) v->resize(n);
+            for (auto* v : {&sold, &pret}) v->resize(n);
+            for (auto* v : {&durata, &procurare, &activare, &expirare}) v->resize(n);
+        }
+
+        // Under the exclusive lock
+        void copiaza(const Sala& sala, size_t inceput, size_t sfarsit) {
+            redimensioneaza(sfarsit - inceput);
+            nume.clear();
+            telefon.clear();
+            for (size_t i = 0; i < numar; i++) {
+                const Client& c = sala.clienti[inceput + i];
+                lungimeNume[i]    = static_cast<uint32_t>(c.nume.size());
+                lungimeTelefon[i] = static_cast<uint32_t>(c.telefon.size());
+                nume    += c.nume;
+                telefon += c.telefon;
+                varsta[i] = static_cast<uint8_t>(c.varsta);
+                sold[i]   = c.sold.bani();
+                tip[i]    = c.abonament.tip();
+                const Abonament* ab = c.abonament.get();
+                stare[i]     = static_cast<uint8_t>(ab ? ab->getStare() : NEPROCURAT);
+                pret[i]      = ab ? ab->getPret().bani() : 0;
+                durata[i]    = ab ? ab->getDurata() : 0;
+                procurare[i] = ab ? ab->getDataProcurarii().zile() : Data().zile();
+                activare[i]  = ab ? ab->getDataActivarii().zile() : Data().zile();
+                expirare[i]  = ab ? ab->getDataExpirarii().zile() : Data().zile();
+            }
+        }
+
+        void codifica(std::string& out, bool compresie) const {
+            const size_t antet = out.size();
+            scrieValoare(out, uint32_t(0));   // marime, patched below
+            scrieValoare(out, static_cast<uint32_t>(numar));
+            scrieValoare(out, uint64_t(0));   // sumaControl, patched below
+            const size_t blocuri = out.size();
+
+            bloc(out, NUME, SIRURI, [&](std::string& o) { siruri(o, lungimeNume, nume); });
+            bloc(out, TELEFON, SIRURI, [&](std::string& o) { siruri(o, lungimeTelefon, telefon); });
+            bloc(out, VARSTA, FIX, [&](std::string& o) { o.append(reinterpret_cast<const char*>(varsta.data()), numar); });
+            numere(out, SOLD, sold, compresie);
+            dictionar(out, TIP, tip, NUME_TIP, compresie);
+            dictionar(out, STARE, stare, NUME_STARE, compresie);
+            numere(out, PRET, pret, compresie);
+            numere(out, DURATA, durata, compresie);
+            date(out, DATA_PROCURARII, procurare, compresie);
+            date(out, DATA_ACTIVARII, activare, compresie);
+            date(out, DATA_EXPIRARII, expirare, compresie);
+
+            const uint32_t marime = static_cast<uint32_t>(out.size() - antet - sizeof(uint32_t));
+            const uint64_t suma = sumaControl(out.data() + blocuri, out.size() - blocuri);
+            std::memcpy(&out[antet], &marime, sizeof(marime));
+            std::memcpy(&out[antet + 2 * sizeof(uint32_t)], &suma, sizeof(suma));
+        }
+
+        template <typename F>
+        static void bloc(std::string& out, Coloana coloana, Codare codare, F&& valori) {
+            out += static_cast<char>(coloana);
+            out += static_cast<char>(codare);
+            const size_t lungime = out.size();
+            scrieValoare(out, uint32_t(0));
+            valori(out);
+            const uint32_t n = static_cast<uint32_t>(out.size() - lungime - sizeof(uint32_t));
+            std::memcpy(&out[lungime], &n, sizeof(n));
+        }
+
+        static void siruri(std::string& out, const std::vector<uint32_t>& lungimi, const std::string& octeti) {
+            for (uint32_t l : lungimi) scrieVarint(out, l);
+            out += octeti;
+        }
+
+        template <typename T>
+        void numere(std::string& out, Coloana coloana, const std::vector<T>& v, bool compresie) const {
+            if (!compresie) {
+                bloc(out, coloana, FIX, [&](std::string& o) { o.append(reinterpret_cast<const char*>(v.data()), numar * sizeof(T)); });
+                return;
+            }
+            bloc(out, coloana, VARINT, [&](std::string& o) {
+                for (T x : v) scrieVarint(o, zigzag(x));
+            });
+        }
+
+        // Dates of clients that bought something are close together, so their
+        // differences fit in one or two bytes; unset dates only cost their bit
+        void date(std::string& out, Coloana coloana, const std::vector<int32_t>& v, bool compresie) const {
+            if (!compresie) {
+                numere(out, coloana, v, false);
+                return;
+            }
+            bloc(out, coloana, DELTA, [&](std::string& o) {
+                const size_t harta = o.size();
+                o.append((numar + 7) / 8, '\0');
+                int64_t anterior = 0;
+                for (size_t i = 0; i < numar; i++) {
+                    if (!Data::dinZile(v[i]).esteDefinita()) continue;
+                    o[harta + i / 8] = static_cast<char>(o[harta + i / 8] | 1 << (i % 8));
+                    scrieVarint(o, zigzag(v[i] - anterior));
+                    anterior = v[i];
+                }
+            });
+        }
+
+        template <size_t N>
+        void dictionar(std::string& out, Coloana coloana, const std::vector<uint8_t>& v,
+                       const char* const (&nume)[N], bool compresie) const {
+            // The values present, in order of first appearance
+            std::array<uint8_t, N> cod;
+            cod.fill(0xFF);
+            std::vector<uint8_t> intrari;
+            size_t rulari = 0;
+            for (size_t i = 0; i < numar; i++) {
+                if (cod[v[i]] == 0xFF) {
+                    cod[v[i]] = static_cast<uint8_t>(intrari.size());
+                    intrari.push_back(v[i]);
+                }
+                rulari += i == 0 || v[i] != v[i - 1];
+            }
+            unsigned biti = 0;
+            while ((size_t(1) << biti) < intrari.size()) biti++;
+
+            // A run costs at least two bytes; bit packing costs `biti` per value
+            const bool rle = compresie && rulari * 2 * 8 < numar * biti;
+            bloc(out, coloana, rle ? DICTIONAR_RLE : DICTIONAR, [&](std::string& o) {
+                o += static_cast<char>(intrari.size());
+                for (uint8_t x : intrari) {
+                    o += static_cast<char>(std::strlen(nume[x]));
+                    o += nume[x];
+                }
+                if (rle) {
+                    for (size_t i = 0; i < numar;) {
+                        size_t j = i;
+                        while (j < numar && v[j] == v[i]) j++;
+                        o += static_cast<char>(cod[v[i]]);
+                        scrieVarint(o, j - i);
+                        i = j;
+                    }
+                    return;
+                }
+                o += static_cast<char>(biti);
+                const size_t inceput = o.size();
+                o.append((numar * biti + 7) / 8, '\0');
+                for (size_t i = 0; i < numar; i++) {
+                    size_t bit = i * biti;   // biti <= 2 divides 8: a code never straddles a byte
+                    o[inceput + bit / 8] = static_cast<char>(o[inceput + bit / 8] | cod[v[i]] << (bit % 8));
+                }
+            });
+        }
+
+        // ---- Reading ----
+
+        bool decodifica(Cursor& c, uint32_t maximRanduri) {
+            uint32_t marime = 0, n = 0;
+            uint64_t suma = 0;
+            if (!c.citeste(marime) || marime < sizeof(n) + sizeof(suma) ||
+                static_cast<size_t>(c.sfarsit - c.p) < marime || !c.citeste(n) || n > maximRanduri || !c.citeste(suma))
+                return false;
+            Cursor blocuri{c.p, c.p + marime - sizeof(n) - sizeof(suma)};
+            if (sumaControl(blocuri.p, static_cast<size_t>(blocuri.sfarsit - blocuri.p)) != suma) return false;
+
+            redimensioneaza(n);
+            for (int k = 0; k < NUMAR_COLOANE; k++) {
+                uint8_t coloana = 0, codare = 0;
+                uint32_t lungime = 0;
+                if (!blocuri.citeste(coloana) || coloana != k || !blocuri.citeste(codare) || !blocuri.citeste(lungime) ||
+                    static_cast<size_t>(blocuri.sfarsit - blocuri.p) < lungime)
+                    return false;
+                Cursor b{blocuri.p, blocuri.p + lungime};
+                blocuri.p += lungime;
+                bool ok = false;
+                switch (coloana) {
+                    case NUME:    ok = codare == SIRURI && citesteSiruri(b, lungimeNume, inceputNume, nume); break;
+                    case TELEFON: ok = codare == SIRURI && citesteSiruri(b, lungimeTelefon, inceputTelefon, telefon); break;
+                    case VARSTA:  ok = codare == FIX && citesteFix(b, varsta); break;
+                    case SOLD:    ok = citesteNumere(b, codare, sold); break;
+                    case TIP:     ok = citesteDictionar(b, codare, tip, NUME_TIP); break;
+                    case STARE:   ok = citesteDictionar(b, codare, stare, NUME_STARE); break;
+                    case PRET:    ok = citesteNumere(b, codare, pret); break;
+                    case DURATA:  ok = citesteNumere(b, codare, durata); break;
+                    default:      ok = citesteDate(b, codare, coloana == DATA_PROCURARII ? procurare
+                                                              : coloana == DATA_ACTIVARII ? activare : expirare);
+                }
+                if (!ok || b.p != b.sfarsit) return false;
+            }
+            c.p = blocuri.sfarsit;
+            return blocuri.p == blocuri.sfarsit;
+        }
+
+        bool citesteSiruri(Cursor& b, std::vector<uint32_t>& lungimi, std::vector<uint32_t>& inceputuri,
+                           std::string& octeti) {
+            inceputuri.resize(numar);
+            uint64_t total = 0;
+            for (size_t i = 0; i < numar; i++) {
+                uint64_t l = 0;
+                if (!b.citesteVarint(l) || l > UINT32_MAX) return false;
+                lungimi[i] = static_cast<uint32_t>(l);
+                inceputuri[i] = static_cast<uint32_t>(total);
+                total += l;
+                if (total > UINT32_MAX) return false;
+            }
+            std::string_view text;
+            if (!b.citesteOcteti(total, text)) return false;
+            octeti.assign(text);
+            return true;
+        }
+
+        template <typename T>
+        bool citesteFix(Cursor& b, std::vector<T>& v) {
+            std::string_view octeti;
+            if (!b.citesteOcteti(numar * sizeof(T), octeti)) return false;
+            if (numar) std::memcpy(v.data(), octeti.data(), octeti.size());
+            return true;
+        }
+
+        template <typename T>
+        bool citesteNumere(Cursor& b, uint8_t codare, std::vector<T>& v) {
+            if (codare == FIX) return citesteFix(b, v);
+            if (codare != VARINT) return false;
+            for (size_t i = 0; i < numar; i++) {
+                uint64_t x = 0;
+                if (!b.citesteVarint(x)) return false;
+                v[i] = static_cast<T>(dinZigzag(x));
+            }
+            return true;
+        }
+
+        bool citesteDate(Cursor& b, uint8_t codare, std::vector<int32_t>& v) {
+            if (codare != DELTA) return citesteNumere(b, codare, v);
+            std::string_view harta;
+            if (!b.citesteOcteti((numar + 7) / 8, harta)) return false;
+            int64_t anterior = 0;
+            for (size_t i = 0; i < numar; i++) {
+                if (!(static_cast<uint8_t>(harta[i / 8]) >> (i % 8) & 1)) {
+                    v[i] = Data().zile();
+                    continue;
+                }
+                uint64_t x = 0;
+                if (!b.citesteVarint(x)) return false;
+                anterior += dinZigzag(x);
+                v[i] = static_cast<int32_t>(anterior);
+            }
+            return true;
+        }
+
+        template <size_t N>
+        bool citesteDictionar(Cursor& b, uint8_t codare, std::vector<uint8_t>& v, const char* const (&nume)[N]) {
+            uint8_t intrari = 0;
+            std::array<uint8_t, 256> valoare{};
+            if (!b.citeste(intrari)) return false;
+            for (unsigned k = 0; k < intrari; k++) {
+                uint8_t l = 0;
+                std::string_view text;
+                if (!b.citeste(l) || !b.citesteOcteti(l, text)) return false;
+                auto gasit = std::find_if(std::begin(nume), std::end(nume), [&](const char* x) { return text == x; });
+                if (gasit == std::end(nume)) return false;
+                valoare[k] = static_cast<uint8_t>(gasit - std::begin(nume));
+            }
+            if (codare == DICTIONAR_RLE) {
+                for (size_t i = 0; i < numar;) {
+                    uint8_t cod = 0;
+                    uint64_t rulare = 0;
+                    if (!b.citeste(cod) || cod >= intrari || !b.citesteVarint(rulare) || rulare == 0 || rulare > numar - i)
+                        return false;
+                    std::fill_n(v.begin() + static_cast<std::ptrdiff_t>(i), rulare, valoare[cod]);
+                    i += rulare;
+                }
+                return true;
+            }
+            uint8_t biti = 0;
+            std::string_view coduri;
+            if (codare != DICTIONAR || !b.citeste(biti) || (biti != 0 && biti != 1 && biti != 2 && biti != 4 && biti != 8) ||
+                !b.citesteOcteti((numar * biti + 7) / 8, coduri))
+                return false;
+            for (size_t i = 0; i < numar; i++) {
+                size_t bit = i * biti;
+                uint8_t cod = biti ? static_cast<uint8_t>(static_cast<uint8_t>(coduri[bit / 8]) >> (bit % 8) & ((1u << biti) - 1)) : 0;
+                if (cod >= intrari) return false;
+                v[i] = valoare[cod];
+            }
+            return true;
+        }
+
+        RandExport rand(size_t i) const {
+            RandExport r;
+            r.nume      = std::string_view(nume).substr(inceputNume[i], lungimeNume[i]);
+            r.telefon   = std::string_view(telefon).substr(inceputTelefon[i], lungimeTelefon[i]);
+            r.varsta    = varsta[i];
+            r.sold      = Bani::dinBani(sold[i]);
+            r.tip       = static_cast<TipAbonament>(tip[i]);
+            r.stare     = static_cast<StareAbonament>(stare[i]);
+            r.pret      = Bani::dinBani(pret[i]);
+            r.durata    = durata[i];
+            r.procurare = Data::dinZile(procurare[i]);
+            r.activare  = Data::dinZile(activare[i]);
+            r.expirare  = Data::dinZile(expirare[i]);
+            return r;
+        }
+    };
+};
+
+#endif // EXPORTANALITIC_H
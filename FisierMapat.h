@@ -0,0 +1,60 @@
+#ifndef FISIERMAPAT_H
+#define FISIERMAPAT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Read-only view of a whole file: mmap where available, a plain read otherwise.
+// The pages are read ahead sequentially; used by the snapshot loader and the CSV import.
+struct FisierMapat {
+    const char* date = nullptr;
+    uint64_t marime = 0;
+#if defined(_WIN32)
+    std::vector<char> continut;
+
+    explicit FisierMapat(const std::string& cale) {
+        std::ifstream in(cale, std::ios::binary | std::ios::ate);
+        if (!in) return;
+        continut.resize(static_cast<size_t>(in.tellg()));
+        in.seekg(0);
+        if (!in.read(continut.data(), continut.size())) return;
+        date = continut.data();
+        marime = continut.size();
+    }
+#else
+    void* mapare = MAP_FAILED;
+
+    explicit FisierMapat(const std::string& cale) {
+        int fd = ::open(cale.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat st;
+        if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+            mapare = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapare != MAP_FAILED) {
+                ::madvise(mapare, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+                date = static_cast<const char*>(mapare);
+                marime = static_cast<uint64_t>(st.st_size);
+            }
+        }
+        ::close(fd);
+    }
+
+    ~FisierMapat() {
+        if (mapare != MAP_FAILED) ::munmap(mapare, marime);
+    }
+#endif
+    FisierMapat(const FisierMapat&) = delete;
+    FisierMapat& operator=(const FisierMapat&) = delete;
+};
+
+#endif // FISIERMAPAT_H
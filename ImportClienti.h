@@ -0,0 +1,334 @@
+#ifndef IMPORTCLIENTI_H
+#define IMPORTCLIENTI_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "Abonament.h"
+#include "Bani.h"
+#include "Client.h"
+#include "Data.h"
+#include "FisierMapat.h"
+#include "Jurnal.h"
+#include "Sala.h"
+#include "Validare.h"
+
+struct RaportImport {
+    size_t linii = 0;       // data rows read (header and blank lines excluded)
+    size_t importati = 0;
+    size_t respinsi = 0;
+    bool deschis = false;   // false if the file could not be read
+};
+
+// Bulk import of members migrated from another system, one CSV row each:
+//
+//   nume,telefon,parola,varsta[,sold[,abonament,data_procurarii[,data_activarii]]]
+//
+// with an optional header row starting with "nume". Fields may be "quoted"
+// (to hold commas, not quotes). abonament is a catalog name as in "procura",
+// or empty for none; with data_activarii the subscription is active and its
+// price, already paid in the old system, is not taken from sold.
+//
+// The file is memory-mapped and handled in segments of MARIME_SEGMENT bytes,
+// so memory stays bounded however large it is. Each segment is cut at line
+// boundaries into one slice per thread, and the threads parse and validate
+// their slices into rows that point into the mapping. The valid rows are then
+// inserted under a single exclusive lock per segment: the phone index is the
+// dedup pass (a phone already seen in the file or already registered is
+// rejected), and each member is journaled as the registration, top-up,
+// purchase and activation it amounts to, so replay rebuilds the same state.
+// Nothing is printed per row.
+//
+// Rejected rows go to `caleRespinse`, if given, as "linie,motiv,rand",
+// in file order.
+class ImportClienti {
+public:
+    static constexpr size_t MARIME_SEGMENT = size_t(32) << 20;
+
+    // fire = 0 uses every hardware thread
+    static RaportImport importa(Sala& sala, const std::string& cale, const std::string& caleRespinse = "",
+                                unsigned fire = 0) {
+        RaportImport raport;
+        FisierMapat fisier(cale);
+        raport.deschis = fisier.date != nullptr || std::ifstream(cale).is_open();   // or empty
+        if (!fisier.date) return raport;
+        std::ofstream respinse;
+        if (!caleRespinse.empty()) respinse.open(caleRespinse, std::ios::binary);
+        if (fire == 0) fire = std::max(1u, std::thread::hardware_concurrency());
+
+        std::string_view text(fisier.date, fisier.marime);
+        if (text.substr(0, 3) == "\xEF\xBB\xBF") text.remove_prefix(3);   // UTF-8 byte order mark
+        std::vector<Felie> felii(fire);
+        std::vector<Respins> respinsi;
+        std::string iesire;
+        size_t inceput = 0, linie = 0;
+        if (text.substr(0, 5) == "nume,") {   // header row
+            inceput = sfarsitLinie(text, 0);
+            linie = 1;
+        }
+        while (inceput < text.size()) {
+            size_t sfarsit = sfarsitLinie(text, std::min(text.size(), inceput + MARIME_SEGMENT) - 1);
+            valideaza(text.substr(inceput, sfarsit - inceput), linie, felii);
+
+            respinsi.clear();
+            for (Felie& f : felii) {
+                raport.linii += f.rinduri;
+                linie += f.linii;
+                respinsi.insert(respinsi.end(), f.respinsi.begin(), f.respinsi.end());
+            }
+            raport.importati += insereaza(sala, felii, respinsi);
+            raport.respinsi += respinsi.size();
+            if (respinse.is_open()) {
+                std::sort(respinsi.begin(), respinsi.end(),
+                          [](const Respins& a, const Respins& b) { return a.linie < b.linie; });
+                iesire.clear();
+                for (const Respins& r : respinsi) {
+                    iesire += std::to_string(r.linie);
+                    iesire += ',';
+                    iesire += r.motiv;
+                    iesire += ',';
+                    iesire += r.rand;
+                    iesire += '\n';
+                }
+                respinse.write(iesire.data(), static_cast<std::streamsize>(iesire.size()));
+            }
+            inceput = sfarsit;
+        }
+        return raport;
+    }
+
+private:
+    // Below this many bytes per thread, starting a thread costs more than it saves
+    static constexpr size_t PRAG_FIR = size_t(1) << 20;
+    static constexpr size_t MAX_CAMPURI = 8;
+
+    // A valid row; the strings point into the mapped file
+    struct Rand {
+        std::string_view text;          // the whole line, for the rejects file
+        std::string_view nume, telefon, parola;
+        std::string_view abonament;     // catalog name, empty for none
+        size_t linie;
+        uint32_t cheie;
+        uint8_t varsta;
+        Bani sold;
+        Data procurare, activare;
+    };
+
+    struct Respins {
+        size_t linie;
+        const char* motiv;
+        std::string_view rand;
+    };
+
+    // What one thread produced from its slice of a segment
+    struct Felie {
+        std::vector<Rand> randuri;
+        std::vector<Respins> respinsi;
+        size_t linii = 0;    // every line, blank ones included, to number the next slice
+        size_t rinduri = 0;  // data rows
+    };
+
+    // Position just past the end of the line containing `i`
+    static size_t sfarsitLinie(std::string_view text, size_t i) {
+        size_t nl = text.find('\n', i);
+        return nl == std::string_view::npos ? text.size() : nl + 1;
+    }
+
+    // Splits a line into fields. False if there are too many or a quote is not closed.
+    static bool campuri(std::string_view linie, std::array<std::string_view, MAX_CAMPURI>& camp, size_t& n) {
+        n = 0;
+        size_t i = 0;
+        while (true) {
+            if (n == MAX_CAMPURI) return false;
+            if (i < linie.size() && linie[i] == '"') {
+                size_t inchis = linie.find('"', i + 1);
+                if (inchis == std::string_view::npos) return false;
+                camp[n++] = linie.substr(i + 1, inchis - i - 1);
+                i = inchis + 1;
+                if (i < linie.size() && linie[i] != ',') return false;
+            } else {
+                size_t virgula = std::min(linie.find(',', i), linie.size());
+                camp[n++] = linie.substr(i, virgula - i);
+                i = virgula;
+            }
+            if (i >= linie.size()) return true;
+            i++;   // past the comma
+        }
+    }
+
+    // nullptr if the row is valid, otherwise why it is not
+    static const char* parseaza(std::string_view linie, Rand& r) {
+        std::array<std::string_view, MAX_CAMPURI> camp;
+        size_t n;
+        if (!campuri(linie, camp, n) || n < 4 || n == 6) return "numar de campuri";
+        if (camp[0].empty() || camp[0].size() > UINT16_MAX) return "nume invalid";
+        if (!cheieTelefon(camp[1], r.cheie)) return "telefon invalid";
+        if (camp[2].empty() || camp[2].size() > UINT16_MAX) return "parola invalida";
+        int varsta = 0;
+        if (camp[3].empty() || camp[3].size() > 3 ||
+            !citesteCifre(camp[3].data(), static_cast<int>(camp[3].size()), varsta) || varsta < 14 || varsta > 100)
+            return "varsta invalida";
+        r.nume    = camp[0];
+        r.telefon = camp[1];
+        r.parola  = camp[2];
+        r.varsta  = static_cast<uint8_t>(varsta);
+        r.sold    = Bani();
+        r.abonament = std::string_view();
+        r.procurare = r.activare = Data();
+        if (n >= 5 && !camp[4].empty() && (!Bani::parseaza(camp[4], r.sold) || r.sold < Bani()))
+            return "sold invalid";
+        if (n >= 7 && !camp[5].empty()) {
+            if (!abonamentDupaNume(camp[5])) return "abonament invalid";
+            r.abonament = camp[5];
+            if (!Data::parseaza(camp[6], r.procurare)) return "data invalida";
+            if (n == 8 && !camp[7].empty() && (!Data::parseaza(camp[7], r.activare) || r.activare < r.procurare))
+                return "data invalida";
+        }
+        return nullptr;
+    }
+
+    // Parses every line of the segment; `primaLinie` lines of the file precede it
+    static void valideaza(std::string_view segment, size_t primaLinie, std::vector<Felie>& felii) {
+        const size_t fire = std::clamp<size_t>(segment.size() / PRAG_FIR, 1, felii.size());
+        std::vector<size_t> margini(felii.size() + 1, segment.size());
+        margini[0] = 0;
+        for (size_t k = 1; k < fire; k++)
+            margini[k] = std::max(margini[k - 1], sfarsitLinie(segment, segment.size() * k / fire - 1));
+
+        auto lucru = [&](size_t k) {
+            Felie& f = felii[k];
+            f.randuri.clear();
+            f.respinsi.clear();
+            f.linii = f.rinduri = 0;
+            std::string_view felie = segment.substr(margini[k], margini[k + 1] - margini[k]);
+            f.randuri.reserve(felie.size() / 32);   // rows are rarely shorter; unused capacity is never touched
+            size_t i = 0;
+            while (i < felie.size()) {
+                size_t sfarsit = sfarsitLinie(felie, i);
+                std::string_view linie = felie.substr(i, sfarsit - i);
+                i = sfarsit;
+                f.linii++;
+                while (!linie.empty() && (linie.back() == '\n' || linie.back() == '\r')) linie.remove_suffix(1);
+                if (linie.empty()) continue;
+                f.rinduri++;
+                Rand r;
+                if (const char* motiv = parseaza(linie, r)) {
+                    f.respinsi.push_back(Respins{f.linii, motiv, linie});
+                } else {
+                    r.text  = linie;
+                    r.linie = f.linii;
+                    f.randuri.push_back(r);
+                }
+            }
+        };
+        std::vector<std::thread> lucratori;
+        for (size_t k = 1; k < felii.size(); k++) {
+            if (k < fire) lucratori.emplace_back(lucru, k);
+            else lucru(k);   // empty slice
+        }
+        lucru(0);
+        for (std::thread& t : lucratori) t.join();
+
+        // Slice-local line numbers become file line numbers (1-based)
+        size_t inainte = primaLinie;
+        for (Felie& f : felii) {
+            for (Rand& r : f.randuri) r.linie += inainte;
+            for (Respins& r : f.respinsi) r.linie += inainte;
+            inainte += f.linii;
+        }
+    }
+
+    // One batch: every valid row of a segment, in file order, under the exclusive lock
+    static size_t insereaza(Sala& sala, const std::vector<Felie>& felii, std::vector<Respins>& respinsi) {
+        size_t numar = 0;
+        for (const Felie& f : felii) numar += f.randuri.size();
+        if (numar == 0) return 0;
+
+        std::unique_lock<std::shared_mutex> scriere(sala.structura);
+        const size_t primul = sala.clienti.size();
+        sala.indexTelefon.rezerva(primul + numar);
+        size_t importati = 0;
+        for (const Felie& f : felii) {
+            for (const Rand& r : f.randuri) {
+                const uint32_t pozitie = static_cast<uint32_t>(sala.clienti.size());
+                if (!sala.indexTelefon.insereaza(r.cheie, pozitie)) {
+                    bool dinFisier = sala.indexTelefon.cauta(r.cheie) >= static_cast<long long>(primul);
+                    respinsi.push_back(Respins{r.linie, dinFisier ? "telefon duplicat" : "telefon existent", r.text});
+                    continue;
+                }
+                adaugaClient(sala, r, pozitie);
+                importati++;
+            }
+        }
+        // Subscriptions that ran out before the gym's date expire right away, as
+        // avanseazaData() would have done; journaled the same way, so replay agrees
+        if (sala.dataCurenta.esteDefinita()) {
+            sala.expiraPanaLa(sala.dataCurenta);
+            OperatieJurnal op = Sala::operatie(OperatieJurnal::DATA_CURENTA, nullptr);
+            op.data = sala.dataCurenta.zile();
+            sala.jurnalizeaza(op);
+        }
+        return importati;
+    }
+
+    // Exclusive lock held, so the ledger and the heap need no mutex of their own
+    static void adaugaClient(Sala& sala, const Rand& r, uint32_t pozitie) {
+        Client& c = sala.clienti.emplace_back(r.nume, r.telefon, r.parola, r.varsta, &sala.memorieSiruri);
+        // A fresh record per operation, as Sala's own mutators build them, so
+        // only the registration carries the name, phone and password
+        auto operatie = [&](OperatieJurnal::Tip tip) {
+            OperatieJurnal op = Sala::operatie(tip, nullptr);
+            op.cheie = r.cheie;
+            return op;
+        };
+        OperatieJurnal op = operatie(OperatieJurnal::INREGISTRARE);
+        op.varsta = r.varsta;
+        op.text1  = c.nume;
+        op.text2  = c.telefon;
+        op.text3  = c.parola;
+        sala.jurnalizeaza(op);
+
+        AbonamentValoare ab = abonamentDupaNume(r.abonament);
+        const bool activ = ab && r.activare.esteDefinita();
+        // An active subscription was paid for: credit its price so that paying
+        // it leaves `sold`, exactly as replaying the records below does
+        Bani credit = r.sold + (activ ? ab->getPret() : Bani());
+        if (credit > Bani()) {
+            c.sold = credit;
+            sala.registru.adauga(pozitie, MiscareSold::ALIMENTARE, credit);
+            OperatieJurnal sold = operatie(OperatieJurnal::SOLD_ADAUGAT);
+            sold.suma = credit;
+            sala.jurnalizeaza(sold);
+        }
+        if (ab) {
+            OperatieJurnal procurare = operatie(OperatieJurnal::PROCURARE);
+            procurare.tipAbonament = ab.tip();
+            procurare.durata       = ab->getDurata();
+            procurare.pret         = ab->getPret();
+            procurare.data         = r.procurare.zile();
+            c.abonament = std::move(ab);
+            c.abonament->procura(r.procurare);
+            sala.jurnalizeaza(procurare);
+        }
+        if (activ) {
+            c.sold -= c.abonament->getPret();
+            sala.registru.adauga(pozitie, MiscareSold::PLATA_ABONAMENT, -c.abonament->getPret());
+            c.abonament->activeaza(r.activare);
+            sala.planificator.programeaza(c.abonament->getDataExpirarii(), pozitie);
+            OperatieJurnal activare = operatie(OperatieJurnal::ACTIVARE);
+            activare.data = r.activare.zile();
+            sala.jurnalizeaza(activare);
+        }
+        sala.adaugaInColoane(c);
+    }
+};
+
+#endif // IMPORTCLIENTI_H
@@ -0,0 +1,195 @@
+#ifndef INDEXINTERVALE_H
+#define INDEXINTERVALE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Data.h"
+
+// Subscription periods [activare, expirare) of the clients, one per client
+// (the one its current subscription had or has; Data::zile() values), for
+// "who is active on day D" and "who was active at some point between two days".
+//
+// Most periods sit in a centered interval tree built over a frozen copy of
+// them. Each node keeps the periods that contain its center, once sorted by
+// start and once by end, so a query stops scanning a node at the first period
+// that does not match: O(log n + k) for k matches. The tree is never patched:
+// a client whose period changes is marked, the tree skips it and the query
+// checks the marked clients directly. Once they pass a sixteenth of all
+// clients the next query rebuilds the tree, so an update is O(1) and a
+// rebuild costs O(log n) per update, amortized.
+class IndexIntervale {
+private:
+    struct Perioada {
+        int32_t inceput;
+        int32_t sfarsit;
+        uint32_t pozitie;
+    };
+
+    // The periods containing `centru` are perioade[primul, primul + numar)
+    // by start, ascending, and dupaSfarsit[...] the same ones by end, descending
+    struct Nod {
+        int32_t centru;
+        uint32_t primul, numar;
+        int32_t stanga = -1, dreapta = -1;
+    };
+
+    std::vector<int32_t> inceput, sfarsit;   // the current period of client i
+    std::vector<uint8_t> modificat;          // changed since the tree was built
+    std::vector<uint32_t> modificari;        // the clients marked so
+    std::vector<Nod> noduri;                 // noduri[0] is the root
+    std::vector<Perioada> dupaInceput, dupaSfarsit;
+
+    static constexpr size_t MINIM_RECONSTRUIRE = 1024;
+    static constexpr int32_t NEDEFINITA = Data().zile();
+
+    bool arePerioada(size_t i) const { return inceput[i] != NEDEFINITA && inceput[i] < sfarsit[i]; }
+
+    // Builds the subtree for perioade[de, pana) and returns its node, or -1
+    int32_t construieste(std::vector<Perioada>& perioade, size_t de, size_t pana, std::vector<int32_t>& capete) {
+        if (de == pana) return -1;
+        // Center: the median endpoint, so each side gets at most half of the periods
+        capete.clear();
+        for (size_t k = de; k < pana; k++) {
+            capete.push_back(perioade[k].inceput);
+            capete.push_back(perioade[k].sfarsit - 1);
+        }
+        std::nth_element(capete.begin(), capete.begin() + capete.size() / 2, capete.end());
+        const int32_t centru = capete[capete.size() / 2];
+
+        // stanga | contin centrul | dreapta
+        auto mijloc = std::partition(perioade.begin() + de, perioade.begin() + pana,
+                                     [&](const Perioada& p) { return p.sfarsit <= centru; });
+        auto dreapta = std::partition(mijloc, perioade.begin() + pana,
+                                      [&](const Perioada& p) { return p.inceput <= centru; });
+        const size_t m = static_cast<size_t>(mijloc - perioade.begin());
+        const size_t d = static_cast<size_t>(dreapta - perioade.begin());
+
+        const int32_t nod = static_cast<int32_t>(noduri.size());
+        noduri.push_back({centru, static_cast<uint32_t>(dupaInceput.size()), static_cast<uint32_t>(d - m)});
+        dupaInceput.insert(dupaInceput.end(), perioade.begin() + m, perioade.begin() + d);
+        dupaSfarsit.insert(dupaSfarsit.end(), perioade.begin() + m, perioade.begin() + d);
+        std::sort(dupaInceput.end() - (d - m), dupaInceput.end(),
+                  [](const Perioada& a, const Perioada& b) { return a.inceput < b.inceput; });
+        std::sort(dupaSfarsit.end() - (d - m), dupaSfarsit.end(),
+                  [](const Perioada& a, const Perioada& b) { return a.sfarsit > b.sfarsit; });
+
+        const int32_t s = construieste(perioade, de, m, capete);
+        const int32_t dr = construieste(perioade, d, pana, capete);
+        noduri[nod].stanga = s;
+        noduri[nod].dreapta = dr;
+        return nod;
+    }
+
+    void reconstruieste() {
+        std::vector<Perioada> perioade;
+        for (size_t i = 0; i < inceput.size(); i++)
+            if (arePerioada(i)) perioade.push_back({inceput[i], sfarsit[i], static_cast<uint32_t>(i)});
+        noduri.clear();
+        dupaInceput.clear();
+        dupaSfarsit.clear();
+        std::vector<int32_t> capete;
+        construieste(perioade, 0, perioade.size(), capete);
+        for (uint32_t i : modificari) modificat[i] = 0;
+        modificari.clear();
+    }
+
+    void actualizeazaArborele() {
+        if (modificari.size() > std::max(MINIM_RECONSTRUIRE, inceput.size() / 16)) reconstruieste();
+    }
+
+    // f(pozitie) for every period overlapping [de, pana), pana > de
+    template <typename F>
+    void suprapuse(int32_t de, int32_t pana, F&& functie) {
+        actualizeazaArborele();
+        if (!noduri.empty()) suprapuseNod(0, de, pana, functie);
+        for (uint32_t i : modificari)
+            if (arePerioada(i) && inceput[i] < pana && sfarsit[i] > de) functie(i);
+    }
+
+    template <typename F>
+    void suprapuseNod(int32_t nod, int32_t de, int32_t pana, F& functie) const {
+        while (nod >= 0) {
+            const Nod& n = noduri[static_cast<size_t>(nod)];
+            const Perioada* p = dupaInceput.data() + n.primul;
+            const Perioada* q = dupaSfarsit.data() + n.primul;
+            if (pana <= n.centru) {
+                // Every period here ends after the range starts: those starting before it ends
+                for (uint32_t k = 0; k < n.numar && p[k].inceput < pana; k++)
+                    if (!modificat[p[k].pozitie]) functie(p[k].pozitie);
+                nod = n.stanga;
+            } else if (de > n.centru) {
+                // Every period here starts before the range ends: those ending after it starts
+                for (uint32_t k = 0; k < n.numar && q[k].sfarsit > de; k++)
+                    if (!modificat[q[k].pozitie]) functie(q[k].pozitie);
+                nod = n.dreapta;
+            } else {
+                for (uint32_t k = 0; k < n.numar; k++)
+                    if (!modificat[p[k].pozitie]) functie(p[k].pozitie);
+                suprapuseNod(n.stanga, de, pana, functie);
+                nod = n.dreapta;
+            }
+        }
+    }
+
+public:
+    size_t dimensiune() const { return inceput.size(); }
+
+    // The next client position, without a period
+    void adauga() {
+        inceput.push_back(NEDEFINITA);
+        sfarsit.push_back(NEDEFINITA);
+        modificat.push_back(0);
+    }
+
+    // Whether client i's period is already [activare, expirare)
+    bool contine(size_t i, Data activare, Data expirare) const {
+        return inceput[i] == activare.zile() && sfarsit[i] == expirare.zile();
+    }
+
+    // Client i's period becomes [activare, expirare); undefined dates remove it. O(1).
+    void seteaza(size_t i, Data activare, Data expirare) {
+        inceput[i] = activare.zile();
+        sfarsit[i] = expirare.zile();
+        if (!modificat[i]) {
+            modificat[i] = 1;
+            modificari.push_back(static_cast<uint32_t>(i));
+        }
+    }
+
+    // Positions of the clients active on `zi`, in no particular order
+    void activiLa(Data zi, std::vector<uint32_t>& rezultat) {
+        suprapuse(zi.zile(), zi.zile() + 1, [&](uint32_t i) { rezultat.push_back(i); });
+    }
+
+    // Positions of the clients active on at least one day of [de, pana]
+    void activiIntre(Data de, Data pana, std::vector<uint32_t>& rezultat) {
+        if (pana < de) return;
+        suprapuse(de.zile(), pana.zile() + 1, [&](uint32_t i) { rezultat.push_back(i); });
+    }
+
+    // numar[d] = clients active on day de + d, for every day of [de, pana], in one
+    // sweep: +1 where a period starts, -1 where it ends, then a running sum
+    void activiPeZi(Data de, Data pana, std::vector<uint32_t>& numar) const {
+        numar.assign(pana < de ? 0 : static_cast<size_t>(pana - de) + 1, 0);
+        if (numar.empty()) return;
+        const int64_t zile = static_cast<int64_t>(numar.size());
+        std::vector<int64_t> diferente(numar.size() + 1, 0);
+        for (size_t i = 0; i < inceput.size(); i++) {
+            if (!arePerioada(i)) continue;
+            const int64_t s = std::max<int64_t>(int64_t(inceput[i]) - de.zile(), 0);
+            const int64_t e = std::min<int64_t>(int64_t(sfarsit[i]) - de.zile(), zile);
+            if (s >= e) continue;
+            diferente[static_cast<size_t>(s)]++;
+            diferente[static_cast<size_t>(e)]--;
+        }
+        int64_t activi = 0;
+        for (size_t d = 0; d < numar.size(); d++) {
+            activi += diferente[d];
+            numar[d] = static_cast<uint32_t>(activi);
+        }
+    }
+};
+
+#endif // INDEXINTERVALE_H
@@ -0,0 +1,113 @@
+#ifndef INDEXSECUNDAR_H
+#define INDEXSECUNDAR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "ColoaneClienti.h"
+
+// Posting lists of client positions, one for every (subscription type, state,
+// age) combination: 4 x 4 x 256 lists, with the ages of one type and state
+// side by side. A filter (FiltruClienti) covers a block of whole lists, so a
+// query visits only the lists it needs and every position it reads is a
+// match: the cost is the size of the result plus at most 4096 list heads,
+// whatever the size of the gym.
+//
+// A client sits in exactly one list, and its place there is remembered, so
+// moving it after a purchase, an activation or an expiry is O(1): the last
+// entry of the old list fills the hole and the client is appended to the new
+// one. The age never changes after registration. Lists are therefore in no
+// particular order.
+class IndexSecundar {
+public:
+    static constexpr size_t NUMAR_TIPURI = 4;     // FARA_ABONAMENT .. TIP_COMBINANT
+    static constexpr size_t NUMAR_STARI  = 4;     // NEPROCURAT .. EXPIRAT
+    static constexpr size_t NUMAR_VARSTE = 256;   // as in ColoaneClienti
+
+private:
+    std::vector<std::vector<uint32_t>> liste;
+    std::vector<uint16_t> listaClient;   // list of client i
+    std::vector<uint32_t> locClient;     // index of client i in that list
+
+    static uint16_t lista(uint8_t tip, uint8_t stare, uint8_t varsta) {
+        return static_cast<uint16_t>(((tip % NUMAR_TIPURI) * NUMAR_STARI + stare % NUMAR_STARI) * NUMAR_VARSTE + varsta);
+    }
+
+    void insereaza(uint32_t pozitie, uint16_t l) {
+        listaClient[pozitie] = l;
+        locClient[pozitie] = static_cast<uint32_t>(liste[l].size());
+        liste[l].push_back(pozitie);
+    }
+
+    // Calls f(l) for every list the filter covers; false if it covers none
+    template <typename F>
+    static bool pentruFiecareLista(const FiltruClienti& f, F&& functie) {
+        const int tipJos = f.tip < 0 ? 0 : f.tip, tipSus = f.tip < 0 ? static_cast<int>(NUMAR_TIPURI) - 1 : f.tip;
+        const int stareJos = f.stare < 0 ? 0 : f.stare;
+        const int stareSus = f.stare < 0 ? static_cast<int>(NUMAR_STARI) - 1 : f.stare;
+        const int varstaJos = std::max(f.varstaMin, 0);
+        const int varstaSus = std::min(f.varstaMax, static_cast<int>(NUMAR_VARSTE) - 1);
+        if (tipSus >= static_cast<int>(NUMAR_TIPURI) || stareSus >= static_cast<int>(NUMAR_STARI) || varstaJos > varstaSus)
+            return false;
+        for (int t = tipJos; t <= tipSus; t++)
+            for (int s = stareJos; s <= stareSus; s++) {
+                const uint16_t primul = lista(static_cast<uint8_t>(t), static_cast<uint8_t>(s), 0);
+                for (int v = varstaJos; v <= varstaSus; v++) functie(static_cast<size_t>(primul + v));
+            }
+        return true;
+    }
+
+public:
+    IndexSecundar() : liste(NUMAR_TIPURI * NUMAR_STARI * NUMAR_VARSTE) {}
+
+    size_t dimensiune() const { return listaClient.size(); }
+
+    // The next client position, as ColoaneClienti::adauga
+    void adauga(uint8_t varsta, uint8_t tip, uint8_t stare) {
+        const uint32_t pozitie = static_cast<uint32_t>(listaClient.size());
+        listaClient.push_back(0);
+        locClient.push_back(0);
+        insereaza(pozitie, lista(tip, stare, varsta));
+    }
+
+    // Whether client i is already filed under this type and state
+    bool contine(size_t i, uint8_t tip, uint8_t stare) const {
+        return listaClient[i] / NUMAR_VARSTE == lista(tip, stare, 0) / NUMAR_VARSTE;
+    }
+
+    // Files client i under its new type and state. O(1).
+    void muta(size_t i, uint8_t tip, uint8_t stare) {
+        const uint16_t vechea = listaClient[i];
+        const uint16_t noua = lista(tip, stare, static_cast<uint8_t>(vechea % NUMAR_VARSTE));
+        if (noua == vechea) return;
+        std::vector<uint32_t>& l = liste[vechea];
+        const uint32_t ultimul = l.back();
+        l[locClient[i]] = ultimul;
+        locClient[ultimul] = locClient[i];
+        l.pop_back();
+        insereaza(static_cast<uint32_t>(i), noua);
+    }
+
+    size_t numara(const FiltruClienti& f) const {
+        size_t total = 0;
+        pentruFiecareLista(f, [&](size_t l) { total += liste[l].size(); });
+        return total;
+    }
+
+    // Calls f(i) for every matching client, grouped by type, state and age
+    template <typename F>
+    void pentruFiecare(const FiltruClienti& f, F&& functie) const {
+        pentruFiecareLista(f, [&](size_t l) {
+            for (uint32_t i : liste[l]) functie(static_cast<size_t>(i));
+        });
+    }
+
+    // Appends the positions of the matching clients, grouped as above
+    void cauta(const FiltruClienti& f, std::vector<uint32_t>& rezultat) const {
+        rezultat.reserve(rezultat.size() + numara(f));
+        pentruFiecareLista(f, [&](size_t l) { rezultat.insert(rezultat.end(), liste[l].begin(), liste[l].end()); });
+    }
+};
+
+#endif // INDEXSECUNDAR_H
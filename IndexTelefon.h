@@ -0,0 +1,87 @@
+#ifndef INDEXTELEFON_H
+#define INDEXTELEFON_H
+
+#include <cstdint>
+#include <vector>
+#include "Validare.h"
+
+// Open-addressing hash index: phone key (see cheieTelefon) -> client position.
+// Linear probing over a flat array of 8-byte slots, so a lookup
+// usually touches a single cache line.
+class IndexTelefon {
+private:
+    struct Slot {
+        uint32_t cheie;
+        uint32_t pozitie;
+    };
+
+    // 8 digits never exceed 99'999'999, so this value is free to mark empty slots
+    static constexpr uint32_t GOL = 0xFFFFFFFFu;
+
+    std::vector<Slot> sloturi;
+    size_t numarChei;
+    unsigned deplasare;   // 32 - log2(capacity)
+
+    size_t pozitieInitiala(uint32_t cheie) const {
+        // Fibonacci hashing: the top bits of the product spread sequential numbers well
+        return (cheie * 2654435769u) >> deplasare;
+    }
+
+    void realoca(size_t capacitateNoua) {
+        std::vector<Slot> vechi;
+        vechi.swap(sloturi);
+        sloturi.assign(capacitateNoua, Slot{GOL, 0});
+        deplasare = 32;
+        for (size_t c = capacitateNoua; c > 1; c >>= 1) deplasare--;
+
+        size_t masca = capacitateNoua - 1;
+        for (const Slot& s : vechi) {
+            if (s.cheie == GOL) continue;
+            size_t i = pozitieInitiala(s.cheie);
+            while (sloturi[i].cheie != GOL) i = (i + 1) & masca;
+            sloturi[i] = s;
+        }
+    }
+
+public:
+    explicit IndexTelefon(size_t capacitateInitiala = 16) : numarChei(0), deplasare(32) {
+        size_t c = 16;
+        while (c < capacitateInitiala) c <<= 1;
+        realoca(c);
+    }
+
+    // Makes room for n keys without further rehashing (load factor <= 0.7)
+    void rezerva(size_t n) {
+        size_t c = sloturi.size();
+        while (n * 10 > c * 7) c <<= 1;
+        if (c != sloturi.size()) realoca(c);
+    }
+
+    // Returns the client position, or -1 if the key is not indexed
+    long long cauta(uint32_t cheie) const {
+        size_t masca = sloturi.size() - 1;
+        for (size_t i = pozitieInitiala(cheie);; i = (i + 1) & masca) {
+            const Slot& s = sloturi[i];
+            if (s.cheie == cheie) return s.pozitie;
+            if (s.cheie == GOL) return -1;
+        }
+    }
+
+    // Returns false if the key is already present
+    bool insereaza(uint32_t cheie, uint32_t pozitie) {
+        rezerva(numarChei + 1);
+        size_t masca = sloturi.size() - 1;
+        size_t i = pozitieInitiala(cheie);
+        while (sloturi[i].cheie != GOL) {
+            if (sloturi[i].cheie == cheie) return false;
+            i = (i + 1) & masca;
+        }
+        sloturi[i] = Slot{cheie, pozitie};
+        numarChei++;
+        return true;
+    }
+
+    size_t dimensiune() const { return numarChei; }
+};
+
+#endif // INDEXTELEFON_H
@@ -0,0 +1,296 @@
+#ifndef INTERPRETORCOMENZI_H
+#define INTERPRETORCOMENZI_H
+
+#include <cstdlib>
+#include <initializer_list>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Abonament.h"
+#include "Afisaj.h"
+#include "Bani.h"
+#include "Client.h"
+#include "Data.h"
+#include "ExportAnalitic.h"
+#include "ImportClienti.h"
+#include "Metrici.h"
+#include "Sala.h"
+
+// Text commands that drive a Sala without the interactive menus,
+// one command per line (arguments separated by spaces, "quotes" for names
+// with spaces, '#' starts a comment):
+//
+//   inregistrare <nume> <telefon> <parola> <varsta>
+//   login <telefon> <parola>          logout
+//   sold <suma>                       retrage <suma>
+//   procura <fitness|piscina|combinant|1|2|3> <YYYY-MM-DD>
+//   activeaza <YYYY-MM-DD>            parola <veche> <noua>
+//   profil                            recomanda
+//   lista                             oferta <telefon> <procent>
+//   data <YYYY-MM-DD>                 statistici [fisier.json]
+//   agregat <tip|toate> <stare|toate> [varsta_min [varsta_max]]
+//   cauta <filtru>                    (the matching members, from the secondary index)
+//   activi <YYYY-MM-DD> [YYYY-MM-DD]  (members active that day, or on some day of the range)
+//   activi_zilnic <YYYY-MM-DD> <YYYY-MM-DD>   (active members on each day)
+//   bonus <suma> <filtru>             discount <procent> [<filtru>]
+//   reconciliere [fire]               recomandari
+//   import <fisier.csv> [respinse.csv]   (see ImportClienti.h)
+//   export <fisier> [necomprimat]        (columnar, see ExportAnalitic.h)
+//
+// where <filtru> is the argument list of "agregat"; discount without a filter
+// prices the catalog. Amounts are lei with at most two decimals ("12.50").
+//
+// Client commands apply to the client of the last successful login.
+// Messages are the menus' ones, rendered by the Afisaj given (silent if none).
+class InterpretorComenzi {
+private:
+    Sala& sala;
+    Afisaj afisaj;
+    Client* client = nullptr;
+
+    static std::vector<std::string> imparte(std::string_view linie) {
+        std::vector<std::string> argumente;
+        size_t i = 0;
+        while (i < linie.size()) {
+            while (i < linie.size() && (linie[i] == ' ' || linie[i] == '\t' || linie[i] == '\r')) i++;
+            if (i >= linie.size() || linie[i] == '#') break;
+            if (linie[i] == '"') {
+                size_t sfarsit = linie.find('"', i + 1);
+                if (sfarsit == std::string_view::npos) sfarsit = linie.size();
+                argumente.emplace_back(linie.substr(i + 1, sfarsit - i - 1));
+                i = sfarsit + 1;
+            } else {
+                size_t sfarsit = i;
+                while (sfarsit < linie.size() && linie[sfarsit] != ' ' && linie[sfarsit] != '\t' &&
+                       linie[sfarsit] != '\r')
+                    sfarsit++;
+                argumente.emplace_back(linie.substr(i, sfarsit - i));
+                i = sfarsit;
+            }
+        }
+        return argumente;
+    }
+
+    static bool numar(const std::string& text, double& valoare) {
+        char* sfarsit = nullptr;
+        valoare = std::strtod(text.c_str(), &sfarsit);
+        return !text.empty() && *sfarsit == '\0';
+    }
+
+    static bool suma(const std::string& text, Bani& valoare) { return Bani::parseaza(text, valoare); }
+
+    static bool intreg(const std::string& text, int& valoare) {
+        char* sfarsit = nullptr;
+        long v = std::strtol(text.c_str(), &sfarsit, 10);
+        valoare = static_cast<int>(v);
+        return !text.empty() && *sfarsit == '\0';
+    }
+
+    bool citesteData(const std::string& text, Data& valoare) const {
+        if (Data::parseaza(text, valoare)) return true;
+        afisaj.linie("Format dată invalid! (YYYY-MM-DD)");
+        return false;
+    }
+
+    // Filter value: -1 for "toate", -2 for an unknown name
+    static int codDupaNume(const std::string& nume, std::initializer_list<const char*> valori) {
+        if (nume == "toate") return -1;
+        int cod = 0;
+        for (const char* n : valori) {
+            if (nume == n) return cod;
+            cod++;
+        }
+        return -2;
+    }
+
+    // <tip|toate> <stare|toate> [varsta_min [varsta_max]] starting at a[primul]
+    static bool citesteFiltru(const std::vector<std::string>& a, size_t primul, FiltruClienti& filtru) {
+        size_t n = a.size();
+        if (n < primul + 2 || n > primul + 4) return false;
+        filtru.tip   = codDupaNume(a[primul], {"fara", "fitness", "piscina", "combinant"});
+        filtru.stare = codDupaNume(a[primul + 1], {"neprocurat", "procurat", "activ", "expirat"});
+        if (filtru.tip == -2 || filtru.stare == -2) return false;
+        if (n > primul + 2 && !intreg(a[primul + 2], filtru.varstaMin)) return false;
+        if (n > primul + 3 && !intreg(a[primul + 3], filtru.varstaMax)) return false;
+        return true;
+    }
+
+    bool necesitaClient() const {
+        if (client) return true;
+        afisaj.linie("Niciun client autentificat!");
+        return false;
+    }
+
+public:
+    explicit InterpretorComenzi(Sala& sala, Afisaj afisaj = Afisaj(std::cout)) : sala(sala), afisaj(afisaj) {}
+
+    Client* getClient() const { return client; }
+
+    // Executes one line. Returns false for unknown commands, bad arguments
+    // and operations the gym refused.
+    bool executa(std::string_view linie) {
+        std::vector<std::string> a = imparte(linie);
+        if (a.empty()) return true;
+        const std::string& comanda = a[0];
+        const size_t n = a.size();
+
+        if (comanda == "inregistrare" && n == 5) {
+            int varsta;
+            if (!intreg(a[4], varsta)) return false;
+            return afisaj(sala.inregistreazaClient(a[1], a[2], a[3], varsta));
+        }
+        if (comanda == "login" && n == 3) {
+            Rezultat rezultat(CodRezultat::CLIENT_INEXISTENT);
+            client = sala.autentificare(a[1], a[2], rezultat);
+            return afisaj(rezultat);
+        }
+        if (comanda == "logout" && n == 1) {
+            client = nullptr;
+            return true;
+        }
+        if ((comanda == "sold" || comanda == "retrage") && n == 2) {
+            Bani s;
+            if (!necesitaClient() || !suma(a[1], s)) return false;
+            return afisaj(comanda == "sold" ? sala.adaugaSold(client, s) : sala.retrageSold(client, s));
+        }
+        if (comanda == "procura" && n == 3) {
+            Data d;
+            if (!necesitaClient() || !citesteData(a[2], d)) return false;
+            AbonamentValoare ab = abonamentDupaNume(a[1]);
+            if (!ab) {
+                afisaj.linie("Optiune invalida!");
+                return false;
+            }
+            return afisaj(sala.procuraAbonament(client, ab, d));
+        }
+        if (comanda == "activeaza" && n == 2) {
+            Data d;
+            if (!necesitaClient() || !citesteData(a[1], d)) return false;
+            return afisaj(sala.activeazaAbonament(client, d));
+        }
+        if (comanda == "parola" && n == 3) {
+            if (!necesitaClient()) return false;
+            return afisaj(sala.schimbaParola(client, a[1], a[2]));
+        }
+        if (comanda == "profil" && n == 1) {
+            if (!necesitaClient()) return false;
+            afisaj.vedere([&](std::ostream& os) { sala.afiseazaProfil(client, os); });
+            return true;
+        }
+        if (comanda == "recomanda" && n == 1) {
+            if (!necesitaClient()) return false;
+            afisaj.vedere([&](std::ostream& os) { sala.recomandaAbonament(client->getTelefon(), os); });
+            return true;
+        }
+        if (comanda == "lista" && n == 1) {
+            afisaj.vedere([&](std::ostream& os) { sala.afiseazaTotiClientii(os); });
+            return true;
+        }
+        if (comanda == "oferta" && n == 3) {
+            double procent;
+            if (!numar(a[2], procent)) return false;
+            return afisaj(sala.ofertaSpeciala(a[1], procent));
+        }
+        if (comanda == "data" && n == 2) {
+            Data d;
+            if (!citesteData(a[1], d)) return false;
+            return afisaj(sala.avanseazaData(d));
+        }
+
+        if (comanda == "agregat") {
+            FiltruClienti filtru;
+            if (!citesteFiltru(a, 1, filtru)) return false;
+            afisaj.linie("Clienti: ", sala.numaraClienti(filtru), ", sold total: ", sala.soldTotal(filtru), " MDL");
+            return true;
+        }
+        if (comanda == "cauta") {
+            FiltruClienti filtru;
+            if (!citesteFiltru(a, 1, filtru)) return false;
+            afisaj.vedere([&](std::ostream& os) { sala.afiseazaClienti(filtru, os); });
+            return true;
+        }
+        if (comanda == "activi" && (n == 2 || n == 3)) {
+            Data de, pana;
+            if (!citesteData(a[1], de) || (n == 3 && !citesteData(a[2], pana))) return false;
+            if (n == 2) pana = de;
+            if (pana < de) return false;
+            afisaj.vedere([&](std::ostream& os) { sala.afiseazaActivi(de, pana, os); });
+            return true;
+        }
+        if (comanda == "activi_zilnic" && n == 3) {
+            Data de, pana;
+            if (!citesteData(a[1], de) || !citesteData(a[2], pana) || pana < de) return false;
+            std::vector<uint32_t> numar = sala.activiPeZi(de, pana);
+            for (size_t d = 0; d < numar.size(); d++) afisaj.linie(de + static_cast<int>(d), ' ', numar[d]);
+            return true;
+        }
+        if (comanda == "bonus" && n >= 2) {
+            FiltruClienti filtru;
+            Bani s;
+            if (!suma(a[1], s) || !citesteFiltru(a, 2, filtru)) return false;
+            return afisaj(sala.bonusGrup(filtru, s));
+        }
+        if (comanda == "discount" && n == 2) {
+            double procent;
+            if (!numar(a[1], procent)) return false;
+            afisaj.vedere([&](std::ostream& os) { sala.afiseazaAbonamenteCuDiscount(os, procent); });
+            return true;
+        }
+        if (comanda == "discount" && n > 2) {
+            FiltruClienti filtru;
+            double procent;
+            if (!numar(a[1], procent) || !citesteFiltru(a, 2, filtru)) return false;
+            std::vector<Bani> preturi;
+            Bani total = sala.preturiCuDiscount(filtru, procent, preturi);
+            afisaj.linie("Clienti: ", sala.numaraClienti(filtru), ", total cu discount: ", total, " MDL");
+            return true;
+        }
+        if (comanda == "reconciliere" && n <= 2) {
+            int fire = 0;
+            if (n == 2 && (!intreg(a[1], fire) || fire < 1)) return false;
+            RaportReconciliere raport = sala.reconciliazaSolduri(static_cast<unsigned>(fire));
+            afisaj.linie("Clienti: ", raport.clienti, ", miscari: ", raport.miscari, ", sold total: ",
+                         raport.totalSolduri, " MDL, registru: ", raport.totalRegistru,
+                         " MDL, neconcordante: ", raport.neconcordante.size());
+            return raport.ok();
+        }
+        if (comanda == "recomandari" && n == 1) {
+            std::vector<uint8_t> recomandari;
+            auto numar = sala.recomandariToti(recomandari);
+            afisaj.linie("Recomandari: fitness ", numar[TIP_FITNESS], ", piscina ", numar[TIP_PISCINA],
+                         ", combinant ", numar[TIP_COMBINANT]);
+            return true;
+        }
+        if (comanda == "import" && (n == 2 || n == 3)) {
+            RaportImport raport = ImportClienti::importa(sala, a[1], n == 3 ? a[2] : "");
+            if (!raport.deschis) {
+                afisaj.linie("Nu pot citi ", a[1], "!");
+                return false;
+            }
+            afisaj.linie("Import: ", raport.linii, " randuri, ", raport.importati, " clienti importati, ",
+                         raport.respinsi, " respinsi");
+            return true;
+        }
+        if (comanda == "export" && (n == 2 || (n == 3 && a[2] == "necomprimat"))) {
+            OptiuniExport optiuni;
+            optiuni.compresie = n == 2;
+            if (!ExportAnalitic::scrie(sala, a[1], optiuni)) {
+                afisaj.linie("Eroare la scrierea ", a[1], "!");
+                return false;
+            }
+            afisaj.linie("Export scris in ", a[1]);
+            return true;
+        }
+        if (comanda == "statistici" && n <= 2) {
+            if (!Metrici::active()) afisaj.linie("Masurarea latentelor este oprita (porniti cu --metrici).");
+            afisaj.vedere([](std::ostream& os) { Metrici::afiseaza(os); });
+            return n == 1 || Metrici::exporta(a[1]);
+        }
+
+        afisaj.linie("Comanda necunoscuta sau argumente gresite: ", comanda);
+        return false;
+    }
+};
+
+#endif // INTERPRETORCOMENZI_H
@@ -0,0 +1,348 @@
+#ifndef JURNAL_H
+#define JURNAL_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "Bani.h"
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// One state mutation, as recorded in the journal. Only the fields relevant
+// to `tip` are meaningful; the client is identified by its phone key.
+// Amounts are Bani, written to disk as int64 bani.
+// The texts are views: they only have to outlive the call to Jurnal::adauga(),
+// and during replay they point into the journal buffer for one callback.
+struct OperatieJurnal {
+    enum Tip : uint8_t {
+        INREGISTRARE = 1,   // text1 = nume, text2 = telefon, text3 = parola, varsta
+        SOLD_ADAUGAT,       // suma (top-ups and bonuses)
+        SOLD_RETRAS,        // suma
+        PROCURARE,          // tipAbonament, durata, pret, data
+        ACTIVARE,           // data
+        PAROLA,             // text1 = parola noua
+        DATA_CURENTA,       // data (gym clock moved, subscriptions may have expired)
+        BONUS_GRUP          // suma to every client matching tipAbonament (0xFF: any),
+                            // durata = stare (-1: any), varsta..data = age range
+    };
+
+    uint64_t secventa = 0;
+    Tip tip = INREGISTRARE;
+    uint32_t cheie = 0;
+    uint8_t varsta = 0;
+    uint8_t tipAbonament = 0;
+    int32_t durata = 0;
+    int32_t data = 0;
+    Bani suma;
+    Bani pret;
+    std::string_view text1, text2, text3;
+};
+
+// Append-only write-ahead journal with group commit.
+//
+// Writers only append the encoded record to an in-memory buffer and get back
+// its sequence number. A background thread writes everything accumulated so
+// far and issues a single fsync for the whole group, either every `interval`
+// or as soon as `pragOcteti` bytes are pending. A caller that must not
+// acknowledge an operation before it is on disk waits with asteaptaDurabil().
+//
+// A failed write or fsync is final: the records of that group may be lost, so
+// nothing from it on is ever reported durable, and later groups are dropped
+// (replay could not apply them past the hole anyway). Only trunchiaza(), once
+// a snapshot holds everything, puts the journal back in service.
+//
+// Frame on disk: [u32 payload length][u32 checksum][payload].
+// Replay stops at the first torn or corrupt frame (a crash mid-write).
+class Jurnal {
+public:
+    // Appends to `cale`; sequence numbers continue after `ultimaSecventa`
+    explicit Jurnal(const std::string& cale, uint64_t ultimaSecventa = 0,
+                    std::chrono::milliseconds interval = std::chrono::milliseconds(5),
+                    size_t pragOcteti = size_t(1) << 20)
+        : cale(cale), interval(interval), pragOcteti(pragOcteti),
+          urmatoareaSecventa(ultimaSecventa + 1), secventaDurabila(ultimaSecventa) {
+        deschide();
+        if (deschis()) fir = std::thread([this] { ruleazaCommit(); });
+    }
+
+    ~Jurnal() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            oprire = true;
+        }
+        cerereCommit.notify_one();
+        if (fir.joinable()) fir.join();
+        inchide();
+    }
+
+    Jurnal(const Jurnal&) = delete;
+    Jurnal& operator=(const Jurnal&) = delete;
+
+    bool deschis() const {
+#if defined(_WIN32)
+        return fisier != nullptr;
+#else
+        return fd >= 0;
+#endif
+    }
+
+    // Buffers the record and returns its sequence number (op.secventa is ignored)
+    uint64_t adauga(const OperatieJurnal& op) {
+        std::unique_lock<std::mutex> lock(mutex);
+        uint64_t secventa = urmatoareaSecventa++;
+        codifica(op, secventa, tampon);
+        bool plin = tampon.size() >= pragOcteti;
+        lock.unlock();
+        if (plin) cerereCommit.notify_one();
+        return secventa;
+    }
+
+    // Blocks until every record up to `secventa` is on disk. Returns false if
+    // they never will be: the journal failed, could not be opened or is closing.
+    bool asteaptaDurabil(uint64_t secventa) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (secventaDurabila >= secventa) return true;
+        if (!deschis() || eroare) return false;
+        cerereCommit.notify_one();
+        commitTerminat.wait(lock, [&] { return secventaDurabila >= secventa || eroare || oprire; });
+        return secventaDurabila >= secventa;
+    }
+
+    bool sincronizeaza() {
+        uint64_t ultima;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ultima = urmatoareaSecventa - 1;
+        }
+        return asteaptaDurabil(ultima);
+    }
+
+    // Checkpoint: a snapshot now covers everything journaled, so drop the file contents
+    // (and clear a failure: nothing before the snapshot needs the journal any more).
+    // Sequence numbers keep increasing. No other thread may append meanwhile.
+    void trunchiaza() {
+        sincronizeaza();
+        std::unique_lock<std::mutex> lock(mutex);
+        commitTerminat.wait(lock, [&] { return !scriereInCurs; });
+        inchide();
+        std::error_code ec;
+        std::filesystem::resize_file(cale, 0, ec);
+        deschide();
+        tampon.clear();
+        secventaDurabila = urmatoareaSecventa - 1;
+        eroare = false;
+        if (deschis() && !fir.joinable()) fir = std::thread([this] { ruleazaCommit(); });
+    }
+
+    uint64_t getNumarSincronizari() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return numarSincronizari;
+    }
+
+    // True once a write or fsync failed; records from that group on are not durable
+    bool areEroare() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return eroare;
+    }
+
+    // Calls aplica(op) for every intact record with secventa > dupaSecventa, in order.
+    // A torn tail left by a crash is cut off so new records follow the last good one.
+    // Returns the highest sequence number found in the file (or dupaSecventa).
+    template <typename F>
+    static uint64_t reda(const std::string& cale, uint64_t dupaSecventa, F&& aplica) {
+        std::vector<char> continut;
+        FILE* f = std::fopen(cale.c_str(), "rb");
+        if (!f) return dupaSecventa;
+        char bloc[1 << 16];
+        size_t citit;
+        while ((citit = std::fread(bloc, 1, sizeof(bloc), f)) > 0)
+            continut.insert(continut.end(), bloc, bloc + citit);
+        std::fclose(f);
+
+        uint64_t ultima = dupaSecventa;
+        size_t poz = 0;
+        while (poz + 8 <= continut.size()) {
+            uint32_t lungime, suma;
+            std::memcpy(&lungime, &continut[poz], 4);
+            std::memcpy(&suma, &continut[poz + 4], 4);
+            if (lungime > continut.size() - poz - 8) break;
+            const char* payload = &continut[poz + 8];
+            OperatieJurnal op;
+            if (sumaControl(payload, lungime) != suma || !decodifica(payload, lungime, op)) break;
+            poz += 8 + lungime;
+            if (op.secventa <= dupaSecventa) continue;
+            aplica(op);
+            ultima = op.secventa;
+        }
+        if (poz < continut.size()) {
+            std::error_code ec;
+            std::filesystem::resize_file(cale, poz, ec);
+        }
+        return ultima;
+    }
+
+private:
+    std::string cale;
+    std::chrono::milliseconds interval;
+    size_t pragOcteti;
+
+    mutable std::mutex mutex;
+    std::condition_variable cerereCommit;
+    std::condition_variable commitTerminat;
+    std::string tampon;             // encoded records not yet handed to the OS
+    uint64_t urmatoareaSecventa;
+    uint64_t secventaDurabila;      // every record up to here is on disk
+    uint64_t numarSincronizari = 0;
+    bool oprire = false;
+    bool scriereInCurs = false;
+    bool eroare = false;
+    std::thread fir;
+
+#if defined(_WIN32)
+    FILE* fisier = nullptr;
+    void deschide() { fisier = std::fopen(cale.c_str(), "ab"); }
+    void inchide() {
+        if (fisier) std::fclose(fisier);
+        fisier = nullptr;
+    }
+    bool scrieSiSincronizeaza(const std::string& date) {
+        return std::fwrite(date.data(), 1, date.size(), fisier) == date.size() &&
+               std::fflush(fisier) == 0;
+    }
+#else
+    int fd = -1;
+    void deschide() { fd = ::open(cale.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644); }
+    void inchide() {
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+    }
+    bool scrieSiSincronizeaza(const std::string& date) {
+        size_t scris = 0;
+        while (scris < date.size()) {
+            ssize_t n = ::write(fd, date.data() + scris, date.size() - scris);
+            if (n < 0) return false;
+            scris += static_cast<size_t>(n);
+        }
+        return ::fsync(fd) == 0;
+    }
+#endif
+
+    // The group commit loop: take whatever accumulated, one write + one fsync for all of it
+    void ruleazaCommit() {
+        std::string grup;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            cerereCommit.wait_for(lock, interval, [&] {
+                return oprire || tampon.size() >= pragOcteti;
+            });
+            if (tampon.empty()) {
+                if (oprire) break;
+                continue;
+            }
+            grup.clear();
+            grup.swap(tampon);
+            uint64_t ultima = urmatoareaSecventa - 1;
+            if (eroare) continue;   // dropped, see the class comment
+
+            // The file is written outside the lock so writers keep appending meanwhile
+            scriereInCurs = true;
+            lock.unlock();
+            bool ok = scrieSiSincronizeaza(grup);
+            lock.lock();
+            scriereInCurs = false;
+
+            numarSincronizari++;
+            if (ok) secventaDurabila = ultima;
+            else eroare = true;
+            commitTerminat.notify_all();
+        }
+        commitTerminat.notify_all();
+    }
+
+    static uint32_t sumaControl(const char* p, size_t n) {
+        uint32_t h = 2166136261u;
+        for (size_t i = 0; i < n; i++) h = (h ^ static_cast<unsigned char>(p[i])) * 16777619u;
+        return h;
+    }
+
+    template <typename T>
+    static void scrie(std::string& out, const T& valoare) {
+        out.append(reinterpret_cast<const char*>(&valoare), sizeof(T));
+    }
+
+    static void scrieText(std::string& out, std::string_view text) {
+        uint16_t lungime = static_cast<uint16_t>(text.size() < UINT16_MAX ? text.size() : UINT16_MAX);
+        scrie(out, lungime);
+        out.append(text.data(), lungime);
+    }
+
+    static void codifica(const OperatieJurnal& op, uint64_t secventa, std::string& out) {
+        size_t inceput = out.size();
+        out.append(8, '\0');   // length + checksum, filled in below
+        scrie(out, secventa);
+        scrie(out, static_cast<uint8_t>(op.tip));
+        scrie(out, op.cheie);
+        scrie(out, op.varsta);
+        scrie(out, op.tipAbonament);
+        scrie(out, op.durata);
+        scrie(out, op.data);
+        scrie(out, op.suma);
+        scrie(out, op.pret);
+        scrieText(out, op.text1);
+        scrieText(out, op.text2);
+        scrieText(out, op.text3);
+
+        uint32_t lungime = static_cast<uint32_t>(out.size() - inceput - 8);
+        uint32_t suma = sumaControl(out.data() + inceput + 8, lungime);
+        std::memcpy(&out[inceput], &lungime, 4);
+        std::memcpy(&out[inceput + 4], &suma, 4);
+    }
+
+    struct Cititor {
+        const char* p;
+        size_t ramas;
+
+        template <typename T>
+        bool citeste(T& valoare) {
+            if (ramas < sizeof(T)) return false;
+            std::memcpy(&valoare, p, sizeof(T));
+            p += sizeof(T);
+            ramas -= sizeof(T);
+            return true;
+        }
+
+        bool citesteText(std::string_view& text) {
+            uint16_t lungime;
+            if (!citeste(lungime) || ramas < lungime) return false;
+            text = std::string_view(p, lungime);
+            p += lungime;
+            ramas -= lungime;
+            return true;
+        }
+    };
+
+    static bool decodifica(const char* payload, size_t lungime, OperatieJurnal& op) {
+        Cititor c{payload, lungime};
+        uint8_t tip;
+        bool ok = c.citeste(op.secventa) && c.citeste(tip) && c.citeste(op.cheie) &&
+                  c.citeste(op.varsta) && c.citeste(op.tipAbonament) && c.citeste(op.durata) &&
+                  c.citeste(op.data) && c.citeste(op.suma) && c.citeste(op.pret) &&
+                  c.citesteText(op.text1) && c.citesteText(op.text2) && c.citesteText(op.text3);
+        if (!ok || tip < OperatieJurnal::INREGISTRARE || tip > OperatieJurnal::BONUS_GRUP) return false;
+        op.tip = static_cast<OperatieJurnal::Tip>(tip);
+        return true;
+    }
+};
+
+#endif // JURNAL_H
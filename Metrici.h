@@ -0,0 +1,287 @@
+#ifndef METRICI_H
+#define METRICI_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Operations whose latency is recorded
+enum class Operatie : uint8_t {
+    SALA_INREGISTRARE,
+    SALA_AUTENTIFICARE,
+    SALA_CAUTARE,
+    SALA_LISTARE,
+    SALA_OFERTA,
+    SALA_RECOMANDARE,
+    SALA_ADAUGA_SOLD,
+    SALA_RETRAGE_SOLD,
+    SALA_PROCURARE,
+    SALA_ACTIVARE,
+    SALA_PAROLA,
+    SALA_AVANSARE_DATA,
+    SALA_BONUS_GRUP,
+    SALA_DISCOUNT_GRUP,
+    SALA_RECONCILIERE,
+    SALA_DESCHIDE_SESIUNE,
+    SALA_SESIUNE,
+    SALA_RECOMANDARE_TIP,
+    SALA_RECOMANDARI_TOTI,
+    SALA_CAUTARE_INDEX,
+    SALA_AFISARE_CAUTARE,
+    SALA_ACTIVI_LA,
+    SALA_ACTIVI_INTRE,
+    SALA_ACTIVI_PE_ZI,
+    SALA_AFISARE_ACTIVI,
+    CLIENT_ADAUGA_SOLD,
+    CLIENT_PROCURARE,
+    CLIENT_ACTIVARE,
+    CLIENT_VERIFICA_PAROLA,
+    CLIENT_PAROLA,
+    CLIENT_PROFIL,
+    NUMAR_OPERATII
+};
+
+inline const char* numeOperatie(Operatie op) {
+    static const char* const nume[] = {
+        "Sala::inregistreazaClient", "Sala::autentificare",     "Sala::operator()",
+        "Sala::afiseazaTotiClientii", "Sala::ofertaSpeciala",   "Sala::recomandaAbonament",
+        "Sala::adaugaSold",          "Sala::retrageSold",       "Sala::procuraAbonament",
+        "Sala::activeazaAbonament",  "Sala::schimbaParola",     "Sala::avanseazaData",
+        "Sala::bonusGrup",           "Sala::preturiCuDiscount", "Sala::reconciliazaSolduri",
+        "Sala::deschideSesiune",     "Sala::clientSesiune",     "Sala::recomandare",
+        "Sala::recomandariToti",     "Sala::cautaClienti",      "Sala::afiseazaClienti",
+        "Sala::activiLa",            "Sala::activiIntre",       "Sala::activiPeZi",
+        "Sala::afiseazaActivi",      "Client::adaugaSold",      "Client::procuraAbonament",
+        "Client::activeazaAbonament", "Client::verificaParola", "Client::schimbaParola",
+        "Client::afiseazaProfil"};
+    static_assert(sizeof(nume) / sizeof(nume[0]) == static_cast<size_t>(Operatie::NUMAR_OPERATII));
+    return nume[static_cast<size_t>(op)];
+}
+
+// Log-linear latency histogram in the style of HdrHistogram: exact below 32 ns,
+// then 16 sub-buckets per power of two (relative error under 6.25%), which
+// covers the whole uint64_t range in 976 counters.
+class HistogramaLatenta {
+public:
+    static constexpr size_t NUMAR_GALETI = 32 + 59 * 16;
+
+    static size_t galeata(uint64_t ns) {
+        if (ns < 32) return static_cast<size_t>(ns);
+        unsigned msb = static_cast<unsigned>(std::bit_width(ns)) - 1;
+        unsigned deplasare = msb - 4;
+        return 32 + (msb - 5) * 16 + static_cast<size_t>((ns >> deplasare) - 16);
+    }
+
+    // Smallest value that falls in bucket g
+    static uint64_t limitaInferioara(size_t g) {
+        if (g < 32) return g;
+        size_t msb = (g - 32) / 16 + 5;
+        return (16 + (g - 32) % 16) << (msb - 4);
+    }
+
+    static uint64_t mijloc(size_t g) {
+        if (g < 32) return g;
+        uint64_t jos = limitaInferioara(g);
+        uint64_t latime = uint64_t(1) << ((g - 32) / 16 + 1);
+        return jos + latime / 2;
+    }
+};
+
+// Aggregated view of one operation across all threads
+struct StatisticaOperatie {
+    uint64_t apeluri = 0;
+    uint64_t sumaNs = 0;
+    uint64_t maxNs = 0;
+    std::array<uint64_t, HistogramaLatenta::NUMAR_GALETI> galeti{};
+
+    uint64_t percentila(double q) const {
+        if (apeluri == 0) return 0;
+        uint64_t tinta = static_cast<uint64_t>(q * static_cast<double>(apeluri - 1)) + 1;
+        uint64_t cumulat = 0;
+        for (size_t g = 0; g < galeti.size(); g++) {
+            cumulat += galeti[g];
+            if (cumulat >= tinta) return std::min(HistogramaLatenta::mijloc(g), maxNs);
+        }
+        return maxNs;
+    }
+
+    double medieNs() const { return apeluri ? static_cast<double>(sumaNs) / static_cast<double>(apeluri) : 0.0; }
+};
+
+// Per-thread counters and histograms for every operation, plus the registry
+// that aggregates them. Each thread writes only its own block, so recording
+// never contends; relaxed atomics only make concurrent reads by the dump well defined.
+class Metrici {
+private:
+    struct Contor {
+        std::atomic<uint64_t> apeluri{0};
+        std::atomic<uint64_t> sumaNs{0};
+        std::atomic<uint64_t> maxNs{0};
+        std::array<std::atomic<uint64_t>, HistogramaLatenta::NUMAR_GALETI> galeti{};
+    };
+
+    struct BlocFir {
+        std::array<Contor, static_cast<size_t>(Operatie::NUMAR_OPERATII)> contoare;
+    };
+
+    static void incrementeaza(std::atomic<uint64_t>& a, uint64_t cu) {
+        a.store(a.load(std::memory_order_relaxed) + cu, std::memory_order_relaxed);
+    }
+
+    struct Registru {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<BlocFir>> blocuri;   // kept after their thread exits
+    };
+
+    static Registru& registru() {
+        static Registru r;
+        return r;
+    }
+
+    static BlocFir& blocFir() {
+        thread_local BlocFir* bloc = [] {
+            Registru& r = registru();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            r.blocuri.push_back(std::make_unique<BlocFir>());
+            return r.blocuri.back().get();
+        }();
+        return *bloc;
+    }
+
+    static std::atomic<bool>& comutator() {
+        static std::atomic<bool> activ{false};
+        return activ;
+    }
+
+public:
+    static bool active() { return comutator().load(std::memory_order_relaxed); }
+    static void activeaza(bool activ) { comutator().store(activ, std::memory_order_relaxed); }
+
+    static void inregistreaza(Operatie op, uint64_t ns) {
+        Contor& c = blocFir().contoare[static_cast<size_t>(op)];
+        incrementeaza(c.apeluri, 1);
+        incrementeaza(c.sumaNs, ns);
+        if (ns > c.maxNs.load(std::memory_order_relaxed)) c.maxNs.store(ns, std::memory_order_relaxed);
+        incrementeaza(c.galeti[HistogramaLatenta::galeata(ns)], 1);
+    }
+
+    static StatisticaOperatie statistica(Operatie op) {
+        StatisticaOperatie s;
+        Registru& r = registru();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        for (const auto& bloc : r.blocuri) {
+            const Contor& c = bloc->contoare[static_cast<size_t>(op)];
+            s.apeluri += c.apeluri.load(std::memory_order_relaxed);
+            s.sumaNs  += c.sumaNs.load(std::memory_order_relaxed);
+            s.maxNs    = std::max(s.maxNs, c.maxNs.load(std::memory_order_relaxed));
+            for (size_t g = 0; g < s.galeti.size(); g++)
+                s.galeti[g] += c.galeti[g].load(std::memory_order_relaxed);
+        }
+        return s;
+    }
+
+    static void reseteaza() {
+        Registru& r = registru();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        for (auto& bloc : r.blocuri)
+            for (Contor& c : bloc->contoare) {
+                c.apeluri.store(0, std::memory_order_relaxed);
+                c.sumaNs.store(0, std::memory_order_relaxed);
+                c.maxNs.store(0, std::memory_order_relaxed);
+                for (auto& g : c.galeti) g.store(0, std::memory_order_relaxed);
+            }
+    }
+
+    // Human-readable table of every operation called at least once
+    static void afiseaza(std::ostream& os) {
+        std::ios_base::fmtflags formatVechi = os.flags();
+        std::streamsize precizieVeche = os.precision();
+        os << "\n" << std::left << std::setw(28) << "Operatie" << std::right << std::setw(10) << "apeluri"
+           << std::setw(11) << "medie ns" << std::setw(10) << "p50 ns" << std::setw(10) << "p90 ns"
+           << std::setw(10) << "p99 ns" << std::setw(12) << "max ns" << "\n";
+        for (size_t i = 0; i < static_cast<size_t>(Operatie::NUMAR_OPERATII); i++) {
+            Operatie op = static_cast<Operatie>(i);
+            StatisticaOperatie s = statistica(op);
+            if (s.apeluri == 0) continue;
+            os << std::left << std::setw(28) << numeOperatie(op) << std::right << std::setw(10) << s.apeluri
+               << std::setw(11) << std::fixed << std::setprecision(0) << s.medieNs()
+               << std::setw(10) << s.percentila(0.50) << std::setw(10) << s.percentila(0.90)
+               << std::setw(10) << s.percentila(0.99) << std::setw(12) << s.maxNs << "\n";
+        }
+        os.flags(formatVechi);
+        os.precision(precizieVeche);
+    }
+
+    // JSON export: summary statistics plus the non-empty histogram buckets
+    // ([lower bound ns, count]) of every operation
+    static bool exporta(const std::string& cale) {
+        std::ofstream out(cale);
+        if (!out) return false;
+        out << "{\n  \"operatii\": [";
+        bool primul = true;
+        for (size_t i = 0; i < static_cast<size_t>(Operatie::NUMAR_OPERATII); i++) {
+            Operatie op = static_cast<Operatie>(i);
+            StatisticaOperatie s = statistica(op);
+            out << (primul ? "\n" : ",\n") << "    {\"nume\": \"" << numeOperatie(op) << "\", \"apeluri\": "
+                << s.apeluri << ", \"suma_ns\": " << s.sumaNs << ", \"max_ns\": " << s.maxNs
+                << ", \"p50_ns\": " << s.percentila(0.50) << ", \"p90_ns\": " << s.percentila(0.90)
+                << ", \"p99_ns\": " << s.percentila(0.99) << ", \"p999_ns\": " << s.percentila(0.999)
+                << ", \"histograma\": [";
+            bool primaGaleata = true;
+            for (size_t g = 0; g < s.galeti.size(); g++) {
+                if (s.galeti[g] == 0) continue;
+                out << (primaGaleata ? "" : ", ") << "[" << HistogramaLatenta::limitaInferioara(g) << ", "
+                    << s.galeti[g] << "]";
+                primaGaleata = false;
+            }
+            out << "]}";
+            primul = false;
+        }
+        out << "\n  ]\n}\n";
+        return static_cast<bool>(out);
+    }
+};
+
+// Times the enclosing scope as one call of `op`. When metrics are switched
+// off at runtime it costs one relaxed load; building with FITZONE_FARA_METRICI
+// removes it entirely.
+#if defined(FITZONE_FARA_METRICI)
+class CronometruOperatie {
+public:
+    explicit CronometruOperatie(Operatie) {}
+};
+#else
+class CronometruOperatie {
+private:
+    Operatie op;
+    bool activ;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    explicit CronometruOperatie(Operatie op) : op(op), activ(Metrici::active()) {
+        if (activ) start = std::chrono::steady_clock::now();
+    }
+
+    ~CronometruOperatie() {
+        if (!activ) return;
+        auto durata = std::chrono::steady_clock::now() - start;
+        Metrici::inregistreaza(op, static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(durata).count()));
+    }
+
+    CronometruOperatie(const CronometruOperatie&) = delete;
+    CronometruOperatie& operator=(const CronometruOperatie&) = delete;
+};
+#endif
+
+#endif // METRICI_H
@@ -0,0 +1,189 @@
+#ifndef MOTORRECOMANDARI_H
+#define MOTORRECOMANDARI_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Abonament.h"
+#include "Bani.h"
+
+// How far along a member is, from the state of their subscription
+enum NivelClient : uint8_t {
+    NIVEL_INCEPATOR,     // never bought one
+    NIVEL_INTERMEDIAR,   // bought but not active yet, or expired
+    NIVEL_AVANSAT,       // active now
+    NUMAR_NIVELURI
+};
+
+inline NivelClient nivelDinStare(StareAbonament stare) {
+    static constexpr NivelClient nivel[] = {NIVEL_INCEPATOR, NIVEL_INTERMEDIAR, NIVEL_AVANSAT, NIVEL_INTERMEDIAR};
+    return nivel[stare & 3];
+}
+
+// One recommendation rule: members in the age range, at the level and holding
+// the subscription type given get `recomandat`. -1 leaves nivel/curent
+// unrestricted, as in FiltruClienti.
+struct RegulaRecomandare {
+    int varstaMin = 0;
+    int varstaMax = 255;
+    int nivel = -1;          // NivelClient
+    int curent = -1;         // TipAbonament held now (FARA_ABONAMENT without one)
+    TipAbonament recomandat = TIP_FITNESS;
+    std::string motiv;
+
+    bool potriveste(int varsta, int nivelClient, int tip) const {
+        return varsta >= varstaMin && varsta <= varstaMax && (nivel < 0 || nivel == nivelClient) &&
+               (curent < 0 || curent == tip);
+    }
+};
+
+class RecomandareAbonament {
+public:
+    virtual ~RecomandareAbonament() {}
+    virtual const Abonament& recomanda(int varsta, int nivel, TipAbonament curent) const = 0;
+};
+
+// The rules are ordered: the first one that matches decides. They are compiled
+// once, when set, into flat tables with one entry for every (age, level, current
+// type) combination, so a recommendation is a single table lookup: no rule is
+// evaluated, nothing is printed and nothing is allocated.
+class MotorRecomandari : public RecomandareAbonament {
+public:
+    static constexpr size_t NUMAR_VARSTE = 256;   // the columns keep ages in a byte
+    static constexpr size_t NUMAR_TIPURI = 4;     // FARA_ABONAMENT .. TIP_COMBINANT
+
+    // The old age-only rule, preceded by rules for members who already have a subscription
+    static std::vector<RegulaRecomandare> reguliImplicite() {
+        return {
+            {.nivel = NIVEL_AVANSAT, .curent = TIP_COMBINANT, .recomandat = TIP_COMBINANT,
+             .motiv = "reinnoire pachet complet"},
+            {.varstaMin = 16, .nivel = NIVEL_AVANSAT, .curent = TIP_FITNESS, .recomandat = TIP_COMBINANT,
+             .motiv = "adauga piscina"},
+            {.varstaMin = 16, .nivel = NIVEL_AVANSAT, .curent = TIP_PISCINA, .recomandat = TIP_COMBINANT,
+             .motiv = "adauga sala de fitness"},
+            {.nivel = NIVEL_INTERMEDIAR, .curent = TIP_FITNESS, .recomandat = TIP_FITNESS, .motiv = "continua cu fitness"},
+            {.nivel = NIVEL_INTERMEDIAR, .curent = TIP_PISCINA, .recomandat = TIP_PISCINA, .motiv = "continua cu piscina"},
+            {.nivel = NIVEL_INTERMEDIAR, .curent = TIP_COMBINANT, .recomandat = TIP_COMBINANT,
+             .motiv = "continua cu pachetul complet"},
+            {.varstaMax = 15, .recomandat = TIP_PISCINA, .motiv = "pentru tineri"},
+            {.varstaMax = 29, .recomandat = TIP_FITNESS, .motiv = "pentru adulti activi"},
+            {.recomandat = TIP_COMBINANT, .motiv = "pentru cei experimentati"},
+        };
+    }
+
+private:
+    static constexpr size_t NUMAR_CELULE = NUMAR_VARSTE * NUMAR_NIVELURI * NUMAR_TIPURI;
+
+    std::vector<Abonament*> abonamenteDisponibile;   // in TipAbonament order
+    std::vector<RegulaRecomandare> reguli;
+    std::array<uint8_t, NUMAR_CELULE> regulaCelula;  // index in reguli
+    std::array<uint8_t, NUMAR_CELULE> tipCelula;     // reguli[regulaCelula[c]].recomandat
+
+    static size_t celula(size_t varsta, size_t nivel, size_t tip) {
+        return (varsta * NUMAR_NIVELURI + nivel) * NUMAR_TIPURI + tip;
+    }
+
+    static size_t celulaClient(int varsta, int nivel, TipAbonament tip) {
+        return celula(static_cast<size_t>(std::clamp(varsta, 0, static_cast<int>(NUMAR_VARSTE) - 1)),
+                      static_cast<size_t>(nivel) % NUMAR_NIVELURI, static_cast<size_t>(tip) % NUMAR_TIPURI);
+    }
+
+public:
+    explicit MotorRecomandari(std::vector<RegulaRecomandare> reguli = reguliImplicite()) {
+        abonamenteDisponibile.push_back(new AbonamentFitness(1, 300_lei));
+        abonamenteDisponibile.push_back(new AbonamentPiscina(1, 250_lei));
+        abonamenteDisponibile.push_back(new AbonamentCombinant(3, 600_lei));
+        seteazaReguli(std::move(reguli));
+    }
+
+    ~MotorRecomandari() {
+        for (auto ab : abonamenteDisponibile)
+            delete ab;
+        abonamenteDisponibile.clear();
+    }
+
+    MotorRecomandari(const MotorRecomandari&) = delete;
+    MotorRecomandari& operator=(const MotorRecomandari&) = delete;
+
+    // Compiles the rules. Throws std::invalid_argument, leaving the old rules in
+    // place, if a rule recommends no subscription or some member would get none.
+    void seteazaReguli(std::vector<RegulaRecomandare> noi) {
+        if (noi.size() > 255) throw std::invalid_argument("Prea multe reguli de recomandare!");
+        for (const RegulaRecomandare& r : noi)
+            if (r.recomandat < TIP_FITNESS || r.recomandat > TIP_COMBINANT)
+                throw std::invalid_argument("Regula de recomandare fara abonament: " + r.motiv);
+
+        std::array<uint8_t, NUMAR_CELULE> regula{}, tip{};
+        for (size_t v = 0; v < NUMAR_VARSTE; v++)
+            for (size_t n = 0; n < NUMAR_NIVELURI; n++)
+                for (size_t t = 0; t < NUMAR_TIPURI; t++) {
+                    size_t k = 0;
+                    while (k < noi.size() && !noi[k].potriveste(static_cast<int>(v), static_cast<int>(n), static_cast<int>(t)))
+                        k++;
+                    if (k == noi.size())
+                        throw std::invalid_argument("Nicio regula de recomandare pentru varsta " + std::to_string(v));
+                    regula[celula(v, n, t)] = static_cast<uint8_t>(k);
+                    tip[celula(v, n, t)] = noi[k].recomandat;
+                }
+        reguli = std::move(noi);
+        regulaCelula = regula;
+        tipCelula = tip;
+    }
+
+    // Prices of the whole catalog with `procent` off, in catalog order
+    std::vector<Bani> preturiCuDiscount(double procent) const {
+        std::vector<Bani> preturi;
+        for (const Abonament* ab : abonamenteDisponibile) preturi.push_back(ab->calculeazaPretDiscount(procent));
+        return preturi;
+    }
+
+    // The rule that decides for this member
+    const RegulaRecomandare& regula(int varsta, int nivel, TipAbonament curent) const {
+        return reguli[regulaCelula[celulaClient(varsta, nivel, curent)]];
+    }
+
+    TipAbonament tipRecomandat(int varsta, int nivel, TipAbonament curent) const {
+        return static_cast<TipAbonament>(tipCelula[celulaClient(varsta, nivel, curent)]);
+    }
+
+    // The catalog entry itself: owned by the engine, valid as long as it lives
+    const Abonament& recomanda(int varsta, int nivel, TipAbonament curent) const override {
+        return *abonamenteDisponibile[tipRecomandat(varsta, nivel, curent) - 1];
+    }
+
+    // rezultat[i] = the TipAbonament recommended to client i of the columns
+    // (ages, subscription types and states, see ColoaneClienti), in one pass
+    void recomandaToti(const uint8_t* varste, const uint8_t* tipuri, const uint8_t* stari, size_t n,
+                       uint8_t* rezultat) const {
+        for (size_t i = 0; i < n; i++)
+            rezultat[i] = tipCelula[celula(varste[i], nivelDinStare(static_cast<StareAbonament>(stari[i])),
+                                           tipuri[i] & (NUMAR_TIPURI - 1))];
+    }
+
+    // FIX: const-correct view that does NOT clone; only used for display
+    void afiseazaAbonamenteDisponibile(std::ostream& os) const {
+        os << "\n========== ABONAMENTE DISPONIBILE ==========\n";
+        for (size_t i = 0; i < abonamenteDisponibile.size(); i++) {
+            os << i + 1 << ". " << abonamenteDisponibile[i]->afiseazaTip() << '\n';
+            os << "   Pret: " << abonamenteDisponibile[i]->getPret() << " MDL\n";
+        }
+        os << "==========================================\n";
+    }
+
+    void afiseazaAbonamenteCuDiscount(std::ostream& os, double procent) const {
+        std::vector<Bani> preturi = preturiCuDiscount(procent);
+        os << "\n========== OFERTA -" << procent << "% ==========\n";
+        for (size_t i = 0; i < abonamenteDisponibile.size(); i++) {
+            os << i + 1 << ". " << abonamenteDisponibile[i]->afiseazaTip() << '\n';
+            os << "   Pret: " << abonamenteDisponibile[i]->getPret() << " -> " << preturi[i] << " MDL\n";
+        }
+        os << "==========================================\n";
+    }
+};
+
+#endif // MOTORRECOMANDARI_H
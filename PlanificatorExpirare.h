@@ -0,0 +1,47 @@
+#ifndef PLANIFICATOREXPIRARE_H
+#define PLANIFICATOREXPIRARE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "Data.h"
+
+// Min-heap of (expiry day, client position) entries.
+// Each tick pops only the entries that are due, so the work per tick is
+// proportional to the number of expiring subscriptions, not to the number of clients.
+// Entries are never removed eagerly: when a subscription is replaced before it
+// expires, the old entry stays in the heap and the caller skips it when it
+// comes due (see Sala::avanseazaData).
+class PlanificatorExpirare {
+public:
+    struct Intrare {
+        Data zi;
+        uint32_t pozitie;
+    };
+
+private:
+    std::vector<Intrare> heap;
+
+    static bool maiTarziu(const Intrare& a, const Intrare& b) { return a.zi > b.zi; }
+
+public:
+    void programeaza(const Data& zi, uint32_t pozitie) {
+        heap.push_back(Intrare{zi, pozitie});
+        std::push_heap(heap.begin(), heap.end(), maiTarziu);
+    }
+
+    // Calls f(intrare) for every entry due on or before azi, earliest first
+    template <typename F>
+    void extrageScadente(const Data& azi, F&& f) {
+        while (!heap.empty() && heap.front().zi <= azi) {
+            std::pop_heap(heap.begin(), heap.end(), maiTarziu);
+            Intrare intrare = heap.back();
+            heap.pop_back();
+            f(intrare);
+        }
+    }
+
+    size_t dimensiune() const { return heap.size(); }
+};
+
+#endif // PLANIFICATOREXPIRARE_H
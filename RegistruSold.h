@@ -0,0 +1,121 @@
+#ifndef REGISTRUSOLD_H
+#define REGISTRUSOLD_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "Bani.h"
+#include "DepozitSegmentat.h"
+
+// One change of one client's balance
+struct MiscareSold {
+    enum Motiv : uint8_t {
+        SOLD_INITIAL,      // balance carried over from a snapshot
+        ALIMENTARE,        // top-up (replayed journal bonuses are recorded as top-ups too)
+        RETRAGERE,
+        BONUS,             // ofertaSpeciala, bonusGrup
+        PLATA_ABONAMENT    // price deducted on activation
+    };
+
+    uint32_t pozitie;      // index of the client in the Sala
+    Motiv motiv;
+    Bani suma;             // negative for withdrawals and payments
+};
+static_assert(sizeof(MiscareSold) == 16);
+
+struct RaportReconciliere {
+    size_t clienti = 0;
+    size_t miscari = 0;
+    Bani totalSolduri;
+    Bani totalRegistru;
+    std::vector<uint32_t> neconcordante;   // clients whose balance differs from their history, ascending
+
+    bool ok() const { return neconcordante.empty() && totalSolduri == totalRegistru; }
+};
+
+// Append-only ledger of every balance movement, in the order they happened.
+// Entries are never changed or removed, and segmented storage means appending
+// never copies the history. Every client's sold must equal the sum of its
+// entries; reconciliaza() checks that for the whole gym at once.
+class RegistruSold {
+private:
+    // Below this many items per thread, starting a thread costs more than it saves
+    static constexpr size_t PRAG_FIR = 1 << 16;
+
+    DepozitSegmentat<MiscareSold, 12> miscari;
+    Bani total;
+
+    // lucru(k, inceput, sfarsit) on `fire` disjoint slices of [0, n); slice 0 runs on the caller
+    template <typename F>
+    static void inParalel(unsigned fire, size_t n, F&& lucru) {
+        std::vector<std::thread> lucratori;
+        for (unsigned k = 1; k < fire; k++)
+            lucratori.emplace_back([&lucru, k, fire, n] { lucru(k, n * k / fire, n * (k + 1) / fire); });
+        lucru(0u, size_t(0), n / fire);
+        for (std::thread& t : lucratori) t.join();
+    }
+
+public:
+    RegistruSold() = default;
+    RegistruSold(const RegistruSold&) = delete;
+    RegistruSold& operator=(const RegistruSold&) = delete;
+
+    void adauga(uint32_t pozitie, MiscareSold::Motiv motiv, Bani suma) {
+        if (suma == Bani()) return;
+        miscari.emplace_back(MiscareSold{pozitie, motiv, suma});
+        total += suma;
+    }
+
+    size_t dimensiune() const { return miscari.size(); }
+    const MiscareSold& operator[](size_t i) const { return miscari[i]; }
+    Bani getTotal() const { return total; }
+
+    // Compares sold(i) with the sum of client i's entries, for i < numarClienti.
+    // Two parallel passes: the threads first add disjoint slices of the ledger
+    // into one array of per-client sums (relaxed atomic adds: integer addition
+    // commutes, so the sums are exact whatever the interleaving), then each
+    // checks a range of clients. sold(i) is called concurrently.
+    // fire = 0 uses every hardware thread.
+    template <typename F>
+    RaportReconciliere reconciliaza(size_t numarClienti, F&& sold, unsigned fire = 0) const {
+        const size_t m = miscari.size();
+        if (fire == 0) fire = std::max(1u, std::thread::hardware_concurrency());
+        fire = static_cast<unsigned>(std::clamp<size_t>((m + numarClienti) / PRAG_FIR, 1, fire));
+
+        std::vector<int64_t> asteptat(numarClienti, 0);
+        inParalel(fire, m, [&](unsigned, size_t inceput, size_t sfarsit) {
+            for (size_t j = inceput; j < sfarsit; j++) {
+                const MiscareSold& ms = miscari[j];
+                if (ms.pozitie < numarClienti)
+                    std::atomic_ref<int64_t>(asteptat[ms.pozitie]).fetch_add(ms.suma.bani(), std::memory_order_relaxed);
+            }
+        });
+
+        std::vector<std::vector<uint32_t>> diferente(fire);
+        std::vector<Bani> solduri(fire);
+        inParalel(fire, numarClienti, [&](unsigned k, size_t inceput, size_t sfarsit) {
+            Bani suma;
+            for (size_t i = inceput; i < sfarsit; i++) {
+                Bani s = sold(i);
+                suma += s;
+                if (s.bani() != asteptat[i]) diferente[k].push_back(static_cast<uint32_t>(i));
+            }
+            solduri[k] = suma;
+        });
+
+        RaportReconciliere raport;
+        raport.clienti = numarClienti;
+        raport.miscari = m;
+        raport.totalRegistru = total;
+        for (unsigned k = 0; k < fire; k++) {
+            raport.totalSolduri += solduri[k];
+            raport.neconcordante.insert(raport.neconcordante.end(), diferente[k].begin(), diferente[k].end());
+        }
+        return raport;
+    }
+};
+
+#endif // REGISTRUSOLD_H
@@ -0,0 +1,52 @@
+#ifndef REZULTAT_H
+#define REZULTAT_H
+
+#include <cstdint>
+#include <string_view>
+#include "Bani.h"
+#include "Data.h"
+
+// Outcome of a Sala or Client operation. The operations print nothing: the
+// menus and the batch interpreter hand the result to an Afisaj, the server
+// answers OK/ERR from it and bulk runs just test it.
+enum class CodRezultat : uint8_t {
+    // succeeded
+    CLIENT_INREGISTRAT,
+    AUTENTIFICAT,
+    SOLD_ADAUGAT,
+    SOLD_RETRAS,
+    ABONAMENT_PROCURAT,
+    ABONAMENT_INLOCUIT,      // procured over an older subscription
+    ABONAMENT_ACTIVAT,
+    PAROLA_SCHIMBATA,
+    BONUS_APLICAT,
+    BONUS_GRUP_APLICAT,
+    DATA_AVANSATA,
+    // refused, nothing changed
+    TELEFON_INVALID,
+    TELEFON_FOLOSIT,
+    VARSTA_INVALIDA,
+    CLIENT_INEXISTENT,
+    PAROLA_INCORECTA,
+    SUMA_INVALIDA,
+    SOLD_INSUFICIENT,
+    FARA_ABONAMENT_PROCURAT,
+    PAROLA_VECHE_INCORECTA,
+    DATA_IN_TRECUT,
+};
+
+// The code plus whatever the message needs; fields an operation does not set stay zero
+struct Rezultat {
+    CodRezultat cod;
+    Bani suma;              // amount added or bonus given; price paid or missing
+    Bani sold;              // the client's balance afterwards
+    Data data;              // expiry of an activated subscription
+    int numar = 0;          // subscriptions expired, clients given a group bonus
+    std::string_view nume;  // who logged in; points into the gym's string pool
+
+    Rezultat(CodRezultat cod) : cod(cod) {}
+
+    explicit operator bool() const { return cod < CodRezultat::TELEFON_INVALID; }
+};
+
+#endif // REZULTAT_H
@@ -0,0 +1,711 @@
+#ifndef SALA_H
+#define SALA_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <memory_resource>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Bani.h"
+#include "Client.h"
+#include "ColoaneClienti.h"
+#include "Data.h"
+#include "DepozitSegmentat.h"
+#include "IndexIntervale.h"
+#include "IndexSecundar.h"
+#include "IndexTelefon.h"
+#include "Jurnal.h"
+#include "Metrici.h"
+#include "MotorRecomandari.h"
+#include "PlanificatorExpirare.h"
+#include "RegistruSold.h"
+#include "Rezultat.h"
+#include "TabelSesiuni.h"
+#include "Validare.h"
+
+// Every public method may be called from several threads at once (front desks,
+// server sessions), except operator[], getColoane(), getIndexSecundar(),
+// getRegistru(), ataseazaJurnal() and the snapshot loader, which are for
+// setup and tests.
+//
+// Locking:
+//  - structura guards what registration changes: the phone index, the storage
+//    and the column sizes. Lookups and single-client operations hold it shared;
+//    registration and whole-gym operations (bulk bonus, moving the date, scans,
+//    snapshots, replay) hold it exclusively.
+//  - A single-client operation also locks its client's shard (position modulo
+//    NUMAR_SHARDURI), so desks serving different clients rarely wait for each other.
+//  - mutexRegistru, mutexPlanificator, mutexSesiuni and mutexIndex cover the
+//    ledger, the expiry heap, the session table and the two secondary indexes,
+//    which every shard uses; they are not needed under the exclusive lock.
+// Locks are taken in that order. Private helpers never lock: the caller holds
+// what they need.
+class Sala {
+private:
+    static constexpr size_t NUMAR_SHARDURI = 64;
+
+    struct alignas(64) Shard {   // one per cache line, so shards don't falsely share
+        std::mutex mutex;
+    };
+
+    mutable std::shared_mutex structura;
+    mutable std::array<Shard, NUMAR_SHARDURI> sharduri;
+    std::mutex mutexRegistru;
+    std::mutex mutexPlanificator;
+    std::mutex mutexSesiuni;
+    mutable std::mutex mutexIndex;
+
+    // Size-class pool for the clients' strings: declared before the clients so it
+    // outlives them, and released in bulk with the Sala. Synchronized, because
+    // password changes on different shards allocate from it concurrently.
+    std::pmr::synchronized_pool_resource memorieSiruri;
+    // Segmented storage: clients are never moved, so the Client* handed out
+    // by autentificare() and operator() stay valid while the gym grows
+    DepozitSegmentat<Client> clienti;
+    std::string numeSala;
+    MotorRecomandari motorRecomandari;
+    IndexTelefon indexTelefon;     // phone key -> position in clienti[]
+    ColoaneClienti coloane;        // numeric fields of clienti[], column by column
+    IndexSecundar indexSecundar;   // clienti[] positions by subscription type, state and age
+    mutable IndexIntervale indexIntervale;   // subscription periods; queries may rebuild it
+    RegistruSold registru;         // every balance movement, by position in clienti[]
+    PlanificatorExpirare planificator;
+    TabelSesiuni sesiuni;          // login tokens -> position in clienti[]
+    Data dataCurenta;
+    Jurnal* jurnal = nullptr;      // optional, not owned
+    std::atomic<uint64_t> ultimaSecventa{0};   // last journal record reflected in this state
+
+    // Position of the client with this phone (any accepted format), or -1
+    int pozitieClient(std::string_view telefon) const {
+        uint32_t cheie;
+        if (!cheieTelefon(telefon, cheie)) return -1;
+        return static_cast<int>(indexTelefon.cauta(cheie));
+    }
+
+    // The client's position if the password matches, -1 otherwise (structura held shared)
+    int autentificaPozitie(std::string_view telefon, std::string_view parola, Rezultat& rezultat) const {
+        int i = pozitieClient(telefon);
+        if (i < 0) {
+            rezultat.cod = CodRezultat::CLIENT_INEXISTENT;
+            return -1;
+        }
+        std::lock_guard<std::mutex> blocare(shard(i));
+        if (!clienti[i].verificaParola(parola)) {
+            rezultat.cod = CodRezultat::PAROLA_INCORECTA;
+            return -1;
+        }
+        rezultat.cod  = CodRezultat::AUTENTIFICAT;
+        rezultat.nume = clienti[i].nume;
+        return i;
+    }
+
+    static int nivelClient(const Client& c) {
+        const Abonament* ab = c.getAbonament();
+        return nivelDinStare(ab ? ab->getStare() : NEPROCURAT);
+    }
+
+    std::mutex& shard(int pozitie) const {
+        return sharduri[static_cast<size_t>(pozitie) % NUMAR_SHARDURI].mutex;
+    }
+
+    // Files clienti[i] under its subscription type, state and period. Balance
+    // changes leave both indexes alone, so they never take mutexIndex.
+    void indexeaza(size_t i) {
+        const uint8_t tip = coloane.getTipuri()[i], stare = coloane.getStari()[i];
+        const Abonament* ab = clienti[i].getAbonament();
+        const Data activare = ab ? ab->getDataActivarii() : Data();
+        const Data expirare = ab ? ab->getDataExpirarii() : Data();
+        const bool perioadaNeschimbata = indexIntervale.contine(i, activare, expirare);
+        if (indexSecundar.contine(i, tip, stare) && perioadaNeschimbata) return;
+        std::lock_guard<std::mutex> blocare(mutexIndex);
+        indexSecundar.muta(i, tip, stare);
+        if (!perioadaNeschimbata) indexIntervale.seteaza(i, activare, expirare);
+    }
+
+    // A client appended to clienti[] goes into the columns and the indexes
+    void adaugaInColoane(const Client& c) {
+        coloane.adauga(c);
+        const size_t i = coloane.dimensiune() - 1;
+        indexSecundar.adauga(coloane.getVarste()[i], coloane.getTipuri()[i], coloane.getStari()[i]);
+        indexIntervale.adauga();
+        indexeaza(i);
+    }
+
+    // After any change to clienti[i], under its shard
+    void actualizeazaColoane(size_t i) {
+        coloane.actualizeaza(i, clienti[i]);
+        indexeaza(i);
+    }
+
+    // Numbered as in afiseazaTotiClientii(), in registration order (exclusive lock held)
+    void afiseazaPozitii(std::vector<uint32_t>& pozitii, std::ostream& os) const {
+        std::sort(pozitii.begin(), pozitii.end());
+        os << "Clienti gasiti: " << pozitii.size() << '\n';
+        for (uint32_t i : pozitii) os << i + 1 << ". " << clienti[i] << '\n';
+    }
+
+    // Records from different shards reach the journal in any order, so keep the highest
+    void jurnalizeaza(const OperatieJurnal& op) {
+        if (!jurnal) return;
+        uint64_t secventa = jurnal->adauga(op);
+        uint64_t ultima = ultimaSecventa.load(std::memory_order_relaxed);
+        while (ultima < secventa &&
+               !ultimaSecventa.compare_exchange_weak(ultima, secventa, std::memory_order_relaxed)) {}
+    }
+
+    // Under the shared lock and the client's shard
+    void inregistreazaMiscare(int pozitie, MiscareSold::Motiv motiv, Bani suma) {
+        std::lock_guard<std::mutex> blocare(mutexRegistru);
+        registru.adauga(static_cast<uint32_t>(pozitie), motiv, suma);
+    }
+
+    static OperatieJurnal operatie(OperatieJurnal::Tip tip, const Client* client) {
+        OperatieJurnal op;
+        op.tip = tip;
+        if (client) cheieTelefon(client->telefon, op.cheie);
+        return op;
+    }
+
+    // Vectorized pass over the balance column, then the new balances go back
+    // into the matching clients (the filter does not depend on the balance),
+    // then one ledger entry per client, in a separate pass that keeps the copy loop tight
+    size_t aplicaBonusGrup(const FiltruClienti& filtru, Bani suma) {
+        size_t potrivite = coloane.aplicaBonus(filtru, suma);
+        const Bani* sold = coloane.getSolduri();
+        coloane.pentruFiecare(filtru, [&](size_t i) { clienti[i].sold = sold[i]; });
+        coloane.pentruFiecare(filtru, [&](size_t i) {
+            registru.adauga(static_cast<uint32_t>(i), MiscareSold::BONUS, suma);
+        });
+        return potrivite;
+    }
+
+    int expiraPanaLa(const Data& azi) {
+        dataCurenta = azi;
+        int expirate = 0;
+        planificator.extrageScadente(azi, [&](const PlanificatorExpirare::Intrare& in) {
+            Abonament* ab = clienti[in.pozitie].abonament.get();
+            // Skip entries left behind by subscriptions that were replaced or already expired
+            if (ab && ab->esteActiv() && ab->getDataExpirarii() == in.zi) {
+                ab->expira();
+                actualizeazaColoane(in.pozitie);
+                expirate++;
+            }
+        });
+        return expirate;
+    }
+
+public:
+    Sala(std::string nume = "FitZone") : numeSala(nume) {}
+    ~Sala() {}
+
+    // The strings are copied once, into the gym's string pool
+    Rezultat inregistreazaClient(std::string_view nume, std::string_view telefon, std::string_view parola,
+                                 int varsta) {
+        CronometruOperatie cronometru(Operatie::SALA_INREGISTRARE);
+        uint32_t cheie;
+        if (!cheieTelefon(telefon, cheie)) return CodRezultat::TELEFON_INVALID;
+        std::unique_lock<std::shared_mutex> scriere(structura);
+        if (indexTelefon.cauta(cheie) >= 0) return CodRezultat::TELEFON_FOLOSIT;
+        if (varsta < 14 || varsta > 100) return CodRezultat::VARSTA_INVALIDA;
+
+        indexTelefon.insereaza(cheie, static_cast<uint32_t>(clienti.size()));
+        const Client& c = clienti.emplace_back(nume, telefon, parola, varsta, &memorieSiruri);
+        adaugaInColoane(c);
+
+        OperatieJurnal op = operatie(OperatieJurnal::INREGISTRARE, nullptr);
+        op.cheie  = cheie;
+        op.varsta = static_cast<uint8_t>(varsta);
+        op.text1  = c.nume;
+        op.text2  = c.telefon;
+        op.text3  = c.parola;
+        jurnalizeaza(op);
+        return CodRezultat::CLIENT_INREGISTRAT;
+    }
+
+    // The client, or nullptr; `rezultat` tells which check failed
+    Client* autentificare(std::string_view telefon, std::string_view parola, Rezultat& rezultat) {
+        CronometruOperatie cronometru(Operatie::SALA_AUTENTIFICARE);
+        std::shared_lock<std::shared_mutex> citire(structura);
+        int i = autentificaPozitie(telefon, parola, rezultat);
+        return i >= 0 ? &clienti[i] : nullptr;
+    }
+
+    Client* autentificare(std::string_view telefon, std::string_view parola) {
+        Rezultat rezultat(CodRezultat::CLIENT_INEXISTENT);
+        return autentificare(telefon, parola, rezultat);
+    }
+
+    // ---- Sessions ----
+
+    // Logs in like autentificare() and opens a session for the client: later
+    // requests present the token instead of the password
+    bool deschideSesiune(std::string_view telefon, std::string_view parola, TokenSesiune& token) {
+        CronometruOperatie cronometru(Operatie::SALA_DESCHIDE_SESIUNE);
+        std::shared_lock<std::shared_mutex> citire(structura);
+        Rezultat rezultat(CodRezultat::CLIENT_INEXISTENT);
+        int i = autentificaPozitie(telefon, parola, rezultat);
+        if (i < 0) return false;
+        std::lock_guard<std::mutex> blocare(mutexSesiuni);
+        token = sesiuni.deschide(static_cast<uint32_t>(i));
+        return true;
+    }
+
+    // The client of an open session, or nullptr once it was closed or expired. O(1).
+    Client* clientSesiune(const TokenSesiune& token) {
+        CronometruOperatie cronometru(Operatie::SALA_SESIUNE);
+        std::shared_lock<std::shared_mutex> citire(structura);
+        int i;
+        {
+            std::lock_guard<std::mutex> blocare(mutexSesiuni);
+            i = sesiuni.rezolva(token);
+        }
+        return i >= 0 ? &clienti[i] : nullptr;
+    }
+
+    bool inchideSesiune(const TokenSesiune& token) {
+        std::lock_guard<std::mutex> blocare(mutexSesiuni);
+        return sesiuni.inchide(token);
+    }
+
+    size_t getNumarSesiuni() {
+        std::lock_guard<std::mutex> blocare(mutexSesiuni);
+        return sesiuni.dimensiune();
+    }
+
+    // The afiseaza* views write to the stream given and never flush it
+    void afiseazaTotiClientii(std::ostream& os) const {
+        CronometruOperatie cronometru(Operatie::SALA_LISTARE);
+        std::unique_lock<std::shared_mutex> scriere(structura);
+        if (clienti.empty()) {
+            os << "Nu exista clienti inregistrati.\n";
+            return;
+        }
+        os << "\n=== LISTA CLIENTI ===\n";
+        for (size_t i = 0; i < clienti.size(); i++)
+            os << i + 1 << ". " << clienti[i] << '\n';
+    }
+
+    Rezultat ofertaSpeciala(const std::string& telefon, double procentReducere) {
+        CronometruOperatie cronometru(Operatie::SALA_OFERTA);
+        std::shared_lock<std::shared_mutex> citire(structura);
+        int i = pozitieClient(telefon);
+        if (i < 0) return CodRezultat::CLIENT_INEXISTENT;
+        std::lock_guard<std::mutex> blocare(shard(i));
+        Bani bonus = (100_lei).procent(procentReducere);
+        clienti[i] += bonus;
+        actualizeazaColoane(static_cast<size_t>(i));
+        if (bonus > Bani()) {
+            inregistreazaMiscare(i, MiscareSold::BONUS, bonus);
+            OperatieJurnal op = operatie(OperatieJurnal::SOLD_ADAUGAT, &clienti[i]);
+            op.suma = bonus;
+            jurnalizeaza(op);
+        }
+        Rezultat r(CodRezultat::BONUS_APLICAT);
+        r.suma = bonus;
+        r.sold = clienti[i].getSold();
+        return r;
+    }
+
+    void recomandaAbonament(const std::string& telefon, std::ostream& os) const {
+        CronometruOperatie cronometru(Operatie::SALA_RECOMANDARE);
+        std::shared_lock<std::shared_mutex> citire(structura);
+        int i = pozitieClient(telefon);
+        if (i < 0) {
+            os << "Client negasit!\n";
+            return;
+        }
+        std::lock_guard<std::mutex> blocare(shard(i));
+        int nivel = nivelClient(clienti[i]);
+        const RegulaRecomandare& regula = motorRecomandari.regula(clienti[i].getVarsta(), nivel, clienti[i].getTipAbonament());
+        const Abonament& ab = motorRecomandari.recomanda(clienti[i].getVarsta(), nivel, clienti[i].getTipAbonament());
+        os << "\nRECOMANDARE AUTOMATA:\n"
+           << "   Tip: " << ab.afiseazaTip() << '\n'
+           << "   Motiv: " << regula.motiv << '\n'
+           << "   Beneficii:\n";
+        ab.afiseazaBeneficii(os);
+    }
+
+    // What recomandaAbonament() would suggest to this client, silently
+    TipAbonament recomandare(const Client* client) const {
+        CronometruOperatie cronometru(Operatie::SALA_RECOMANDARE_TIP);
+        std::shared_lock<std::shared_mutex> citire(structura);
+        std::lock_guard<std::mutex> blocare(shard(pozitieClient(client->telefon)));
+        return motorRecomandari.tipRecomandat(client->getVarsta(), nivelClient(*client), client->getTipAbonament());
+    }
+
+    // The recommendation for every client, by position, in one pass over the
+    // columns. Returns how many clients got each TipAbonament.
+    std::array<size_t, MotorRecomandari::NUMAR_TIPURI> recomandariToti(std::vector<uint8_t>& rezultat) const {
+        CronometruOperatie cronometru(Operatie::SALA_RECOMANDARI_TOTI);
+        std::unique_lock<std::shared_mutex> scriere(structura);
+        rezultat.resize(coloane.dimensiune());
+        motorRecomandari.recomandaToti(coloane.getVarste(), coloane.getTipuri(), coloane.getStari(),
+                                       rezultat.size(), rezultat.data());
+        std::array<size_t, MotorRecomandari::NUMAR_TIPURI> numar{};
+        for (uint8_t tip : rezultat) numar[tip]++;
+        return numar;
+    }
+
+    // Changes made directly on the returned client bypass the journal, the
+    // columnar copy, the balance ledger and the locks; use the mutation methods below
+    Client& operator[](int index) {
+        if (index >= 0 && static_cast<size_t>(index) < clienti.size())
+            return clienti[index];
+        throw std::out_of_range("Index invalid!");
+    }
+
+    Client* operator()(const std::string& telefon) {
+        CronometruOperatie cronometru(Operatie::SALA_CAUTARE);
+        std::shared_lock<std::shared_mutex> citire(structura);
+        int i = pozitieClient(telefon);
+        return i >= 0 ? &clienti[i] : nullptr;
+    }
+
+    // Storage grows on demand, so the gym is never full
+    bool operator!() const { return false; }
+    operator int()   const { return getNumarClienti(); }
+    int getNumarClienti() const {
+        std::shared_lock<std::shared_mutex> citire(structura);
+        return static_cast<int>(clienti.size());
+    }
+
+    void afiseazaAbonamentePentruProcurare(std::ostream& os) const {
+        motorRecomandari.afiseazaAbonamenteDisponibile(os);
+    }
+
+    void afiseazaAbonamenteCuDiscount(std::ostream& os, double procent) const {
+        motorRecomandari.afiseazaAbonamenteCuDiscount(os, procent);
+    }
+
+    // ---- Single-client operations ----
+    // `client` comes from autentificare() or operator(). Mutations go through the
+    // gym so they are locked, journaled (and scheduled, for activations).
+
+    void afiseazaProfil(const Client* client, std::ostream& os) const {
+        std::shared_lock<std::shared_mutex> citire(structura);
+        std::lock_guard<std::mutex> blocare(shard(pozitieClient(client->telefon)));
+        client->afiseazaProfil(os);
+    }
+
+    Rezultat adaugaSold(Client* client, Bani suma) {
+        CronometruOperatie cronometru(Operatie::SALA_ADAUGA_SOLD);
+        std::shared_lock<std::shared_mutex> citire(structura);
+        int i = pozitieClient(client->telefon);
+        std::lock_guard<std::mutex> blocare(shard(i));
+        Rezultat r = client->adaugaSold(suma);
+        if (!r) return r;
+        actualizeazaColoane(static_cast<size_t>(i));
+        inregistreazaMiscare(i, MiscareSold::ALIMENTARE, suma);
+        OperatieJurnal op = operatie(OperatieJurnal::SOLD_ADAUGAT, client);
+        op.suma = suma;
+        jurnalizeaza(op);
+        return r;
+    }
+
+    Rezultat retrageSold(Client* client, Bani suma) {
+        CronometruOperatie cronometru(Operatie::SALA_RETRAGE_SOLD);
+        std::shared_lock<std::shared_mutex> citire(structura);
+        int i = pozitieClient(client->telefon);
+        std::lock_guard<std::mutex> blocare(shard(i));
+        Rezultat r(CodRezultat::SUMA_INVALIDA);
+        r.suma = suma;
+        r.sold = client->getSold();
+        if (suma <= Bani()) return r;
+        if (suma > client->getSold()) {
+            r.cod = CodRezultat::SOLD_INSUFICIENT;
+            return r;
+        }
+        *client -= suma;
+        actualizeazaColoane(static_cast<size_t>(i));
+        inregistreazaMiscare(i, MiscareSold::RETRAGERE, -suma);
+        OperatieJurnal op = operatie(OperatieJurnal::SOLD_RETRAS, client);
+        op.suma = suma;
+        jurnalizeaza(op);
+        r.cod  = CodRezultat::SOLD_RETRAS;
+        r.sold = client->getSold();
+        return r;
+    }
+
+    Rezultat procuraAbonament(Client* client, AbonamentValoare ab, const Data& data) {
+        CronometruOperatie cronometru(Operatie::SALA_PROCURARE);
+        OperatieJurnal op = operatie(OperatieJurnal::PROCURARE, client);
+        op.tipAbonament = ab.tip();
+        op.durata       = ab->getDurata();
+        op.pret         = ab->getPret();
+        op.data         = data.zile();
+        std::shared_lock<std::shared_mutex> citire(structura);
+        int i = pozitieClient(client->telefon);
+        std::lock_guard<std::mutex> blocare(shard(i));
+        Rezultat r = client->procuraAbonament(std::move(ab), data);
+        actualizeazaColoane(static_cast<size_t>(i));
+        jurnalizeaza(op);
+        return r;
+    }
+
+    Rezultat activeazaAbonament(Client* client, const Data& dataA) {
+        CronometruOperatie cronometru(Operatie::SALA_ACTIVARE);
+        std::shared_lock<std::shared_mutex> citire(structura);
+        int i = pozitieClient(client->telefon);
+        std::lock_guard<std::mutex> blocare(shard(i));
+        Rezultat r = client->activeazaAbonament(dataA);
+        if (!r) return r;
+        {
+            std::lock_guard<std::mutex> blocarePlanificator(mutexPlanificator);
+            planificator.programeaza(client->abonament->getDataExpirarii(), static_cast<uint32_t>(i));
+        }
+        actualizeazaColoane(static_cast<size_t>(i));
+        inregistreazaMiscare(i, MiscareSold::PLATA_ABONAMENT, -client->abonament->getPret());
+        OperatieJurnal op = operatie(OperatieJurnal::ACTIVARE, client);
+        op.data = dataA.zile();
+        jurnalizeaza(op);
+        return r;
+    }
+
+    Rezultat schimbaParola(Client* client, const std::string& parolaVeche, const std::string& parolaNoua) {
+        CronometruOperatie cronometru(Operatie::SALA_PAROLA);
+        std::shared_lock<std::shared_mutex> citire(structura);
+        std::lock_guard<std::mutex> blocare(shard(pozitieClient(client->telefon)));
+        Rezultat r = client->schimbaParola(parolaVeche, parolaNoua);
+        if (!r) return r;
+        OperatieJurnal op = operatie(OperatieJurnal::PAROLA, client);
+        op.text1 = parolaNoua;
+        jurnalizeaza(op);
+        return r;
+    }
+
+    // Moves the gym clock to `azi` and expires every ACTIV subscription whose
+    // expiry date has been reached. The result counts the subscriptions expired.
+    Rezultat avanseazaData(const Data& azi) {
+        CronometruOperatie cronometru(Operatie::SALA_AVANSARE_DATA);
+        std::unique_lock<std::shared_mutex> scriere(structura);
+        if (dataCurenta.esteDefinita() && azi < dataCurenta) return CodRezultat::DATA_IN_TRECUT;
+        Rezultat r(CodRezultat::DATA_AVANSATA);
+        r.numar = expiraPanaLa(azi);
+        r.data  = azi;
+        OperatieJurnal op = operatie(OperatieJurnal::DATA_CURENTA, nullptr);
+        op.data = azi.zile();
+        jurnalizeaza(op);
+        return r;
+    }
+
+    // ---- Bulk operations ----
+    // Chain-wide promotions over the columnar copy, one vector of clients per
+    // step, under the exclusive lock
+
+    // Adds `suma` to every client matching the filter; one journal record for all of them.
+    // The result counts the clients who got the bonus.
+    Rezultat bonusGrup(const FiltruClienti& filtru, Bani suma) {
+        CronometruOperatie cronometru(Operatie::SALA_BONUS_GRUP);
+        if (suma <= Bani()) return CodRezultat::SUMA_INVALIDA;
+        std::unique_lock<std::shared_mutex> scriere(structura);
+        size_t potrivite = aplicaBonusGrup(filtru, suma);
+        OperatieJurnal op = operatie(OperatieJurnal::BONUS_GRUP, nullptr);
+        op.tipAbonament = filtru.tip < 0 ? 0xFF : static_cast<uint8_t>(filtru.tip);
+        op.durata       = filtru.stare < 0 ? -1 : filtru.stare;
+        op.varsta       = static_cast<uint8_t>(std::clamp(filtru.varstaMin, 0, 255));
+        op.data         = filtru.varstaMax;
+        op.suma         = suma;
+        jurnalizeaza(op);
+        Rezultat r(CodRezultat::BONUS_GRUP_APLICAT);
+        r.suma  = suma;
+        r.numar = static_cast<int>(potrivite);
+        return r;
+    }
+
+    // preturi[i] = subscription price of client i with `procent` off, 0 outside
+    // the segment. Returns what the segment would pay in total.
+    Bani preturiCuDiscount(const FiltruClienti& filtru, double procent, std::vector<Bani>& preturi) const {
+        CronometruOperatie cronometru(Operatie::SALA_DISCOUNT_GRUP);
+        std::unique_lock<std::shared_mutex> scriere(structura);
+        preturi.resize(coloane.dimensiune());
+        return coloane.preturiCuDiscount(filtru, procent, preturi.data());
+    }
+
+    // ---- Journal ----
+
+    // Every mutation from now on is appended to j (pass nullptr to stop).
+    // Not synchronized: attach before the desks start and detach after they stop.
+    void ataseazaJurnal(Jurnal* j) { jurnal = j; }
+
+    // Waits until every mutation made so far is on disk. False if they are not
+    // and will not be (the journal failed): the caller must not acknowledge them.
+    bool confirmaJurnal() {
+        return !jurnal || jurnal->asteaptaDurabil(ultimaSecventa);
+    }
+
+    uint64_t getUltimaSecventa() const { return ultimaSecventa; }
+
+    // Replays one journal record silently. Records refer to clients by phone key,
+    // so they apply the same way whatever order the snapshot stored clients in.
+    void aplicaOperatie(const OperatieJurnal& op) {
+        std::unique_lock<std::shared_mutex> scriere(structura);
+        ultimaSecventa = op.secventa;
+        if (op.tip == OperatieJurnal::INREGISTRARE) {
+            if (indexTelefon.insereaza(op.cheie, static_cast<uint32_t>(clienti.size())))
+                adaugaInColoane(clienti.emplace_back(op.text1, op.text2, op.text3, op.varsta, &memorieSiruri));
+            return;
+        }
+        if (op.tip == OperatieJurnal::DATA_CURENTA) {
+            expiraPanaLa(Data::dinZile(op.data));
+            return;
+        }
+        if (op.tip == OperatieJurnal::BONUS_GRUP) {
+            FiltruClienti filtru;
+            filtru.tip       = op.tipAbonament == 0xFF ? -1 : op.tipAbonament;
+            filtru.stare     = op.durata;
+            filtru.varstaMin = op.varsta;
+            filtru.varstaMax = op.data;
+            aplicaBonusGrup(filtru, op.suma);
+            return;
+        }
+
+        long long i = indexTelefon.cauta(op.cheie);
+        if (i < 0) return;
+        Client& c = clienti[static_cast<size_t>(i)];
+        switch (op.tip) {
+            case OperatieJurnal::SOLD_ADAUGAT:
+                c.sold += op.suma;
+                registru.adauga(static_cast<uint32_t>(i), MiscareSold::ALIMENTARE, op.suma);
+                break;
+            case OperatieJurnal::SOLD_RETRAS:
+                c.sold -= op.suma;
+                registru.adauga(static_cast<uint32_t>(i), MiscareSold::RETRAGERE, -op.suma);
+                break;
+            case OperatieJurnal::PROCURARE:
+                c.abonament = creeazaAbonament(static_cast<TipAbonament>(op.tipAbonament), op.durata, op.pret);
+                if (c.abonament) c.abonament->procura(Data::dinZile(op.data));
+                break;
+            case OperatieJurnal::ACTIVARE:
+                if (c.abonament) {
+                    c.sold -= c.abonament->getPret();
+                    registru.adauga(static_cast<uint32_t>(i), MiscareSold::PLATA_ABONAMENT, -c.abonament->getPret());
+                    c.abonament->activeaza(Data::dinZile(op.data));
+                    planificator.programeaza(c.abonament->getDataExpirarii(), static_cast<uint32_t>(i));
+                }
+                break;
+            case OperatieJurnal::PAROLA:
+                c.parola.assign(op.text1);
+                break;
+            default:
+                break;
+        }
+        actualizeazaColoane(static_cast<size_t>(i));
+    }
+
+    Data getDataCurenta() const {
+        std::shared_lock<std::shared_mutex> citire(structura);
+        return dataCurenta;
+    }
+
+    // ---- Analytics ----
+    // Scans over the columnar copy: they never touch the Client objects.
+    // The exclusive lock gives them a consistent picture of every client.
+
+    const ColoaneClienti& getColoane() const { return coloane; }
+
+    Bani soldTotal(const FiltruClienti& filtru) const {
+        std::unique_lock<std::shared_mutex> scriere(structura);
+        return coloane.soldTotal(filtru);
+    }
+
+    // ---- Secondary index ----
+    // Answered from the posting lists of IndexSecundar, in time proportional
+    // to the number of matching clients rather than to the size of the gym
+
+    const IndexSecundar& getIndexSecundar() const { return indexSecundar; }
+
+    size_t numaraClienti(const FiltruClienti& filtru) const {
+        std::shared_lock<std::shared_mutex> citire(structura);
+        std::lock_guard<std::mutex> blocare(mutexIndex);
+        return indexSecundar.numara(filtru);
+    }
+
+    // Positions in clienti[] of the matching clients, grouped by type, state and age
+    std::vector<uint32_t> cautaClienti(const FiltruClienti& filtru) const {
+        CronometruOperatie cronometru(Operatie::SALA_CAUTARE_INDEX);
+        std::shared_lock<std::shared_mutex> citire(structura);
+        std::lock_guard<std::mutex> blocare(mutexIndex);
+        std::vector<uint32_t> pozitii;
+        indexSecundar.cauta(filtru, pozitii);
+        return pozitii;
+    }
+
+    // The matching clients in registration order, numbered as in afiseazaTotiClientii()
+    void afiseazaClienti(const FiltruClienti& filtru, std::ostream& os) const {
+        CronometruOperatie cronometru(Operatie::SALA_AFISARE_CAUTARE);
+        std::unique_lock<std::shared_mutex> scriere(structura);
+        std::vector<uint32_t> pozitii;
+        indexSecundar.cauta(filtru, pozitii);
+        afiseazaPozitii(pozitii, os);
+    }
+
+    // ---- Subscription periods ----
+    // Answered from IndexIntervale. A period runs from the activation day up
+    // to the expiry day, which is no longer active; it stays on record once
+    // the subscription expired, until the client buys another one.
+
+    // Positions in clienti[] of the clients active on `zi`, in no particular order
+    std::vector<uint32_t> activiLa(const Data& zi) const {
+        CronometruOperatie cronometru(Operatie::SALA_ACTIVI_LA);
+        std::shared_lock<std::shared_mutex> citire(structura);
+        std::lock_guard<std::mutex> blocare(mutexIndex);
+        std::vector<uint32_t> pozitii;
+        indexIntervale.activiLa(zi, pozitii);
+        return pozitii;
+    }
+
+    // Positions of the clients active on at least one day of [de, pana]
+    std::vector<uint32_t> activiIntre(const Data& de, const Data& pana) const {
+        CronometruOperatie cronometru(Operatie::SALA_ACTIVI_INTRE);
+        std::shared_lock<std::shared_mutex> citire(structura);
+        std::lock_guard<std::mutex> blocare(mutexIndex);
+        std::vector<uint32_t> pozitii;
+        indexIntervale.activiIntre(de, pana, pozitii);
+        return pozitii;
+    }
+
+    // How many clients were active on each day of [de, pana]
+    std::vector<uint32_t> activiPeZi(const Data& de, const Data& pana) const {
+        CronometruOperatie cronometru(Operatie::SALA_ACTIVI_PE_ZI);
+        std::shared_lock<std::shared_mutex> citire(structura);
+        std::lock_guard<std::mutex> blocare(mutexIndex);
+        std::vector<uint32_t> numar;
+        indexIntervale.activiPeZi(de, pana, numar);
+        return numar;
+    }
+
+    // The clients active on some day of [de, pana], listed like afiseazaClienti()
+    void afiseazaActivi(const Data& de, const Data& pana, std::ostream& os) const {
+        CronometruOperatie cronometru(Operatie::SALA_AFISARE_ACTIVI);
+        std::unique_lock<std::shared_mutex> scriere(structura);
+        std::vector<uint32_t> pozitii;
+        indexIntervale.activiIntre(de, pana, pozitii);
+        afiseazaPozitii(pozitii, os);
+    }
+
+    // ---- Balance ledger ----
+
+    const RegistruSold& getRegistru() const { return registru; }
+
+    // Checks every client's sold against its ledger history, in parallel
+    // (fire = 0: every hardware thread). Balances changed through operator[]
+    // show up as mismatches.
+    RaportReconciliere reconciliazaSolduri(unsigned fire = 0) const {
+        CronometruOperatie cronometru(Operatie::SALA_RECONCILIERE);
+        std::unique_lock<std::shared_mutex> scriere(structura);
+        return registru.reconciliaza(clienti.size(), [this](size_t i) { return clienti[i].sold; }, fire);
+    }
+
+    friend class Snapshot;
+    friend class ImportClienti;
+    friend class ExportAnalitic;
+};
+
+#endif // SALA_H
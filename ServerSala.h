@@ -0,0 +1,483 @@
+#ifndef SERVERSALA_H
+#define SERVERSALA_H
+
+#if defined(__linux__)
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "Abonament.h"
+#include "Bani.h"
+#include "Client.h"
+#include "Data.h"
+#include "Sala.h"
+#include "TabelSesiuni.h"
+
+// Serves a Sala on a local socket: a port number listens on 127.0.0.1:port,
+// anything else is the path of a Unix socket.
+//
+// Protocol: one request per line, answered by one line, in order. Clients may
+// send several requests without waiting (pipelining).
+//
+//   inregistrare <nume> <telefon> <parola> <varsta>    OK
+//   login <telefon> <parola>                           OK <token>
+//   sesiune <token>                                    OK
+//   logout                                             OK
+//   sold <suma>                                        OK
+//   procura <fitness|piscina|combinant|1|2|3> <data>   OK
+//   activeaza <YYYY-MM-DD>                             OK
+//   recomanda                                          OK <fitness|piscina|combinant>
+//
+// Arguments are those of the batch commands (InterpretorComenzi.h). Client
+// requests apply to the connection's session: the last successful login, or
+// a token from an earlier login presented with "sesiune" (a reconnecting
+// client skips the password check). Every client request resolves the token
+// again, so a session closed by logout or expired stops working on every
+// connection that uses it.
+// Failures answer "ERR <motiv>": comanda (unknown command or bad arguments),
+// neautentificat (no session on this connection, or it was closed or expired),
+// refuzat (the gym refused the operation or the token), lung (a line over LUNGIME_MAXIMA; the connection is then closed).
+//
+// Each worker thread owns an epoll set. The listening socket is in all of them
+// with EPOLLEXCLUSIVE, so a new connection wakes one worker, which keeps it for
+// life. Sockets are non-blocking and edge-triggered. A worker answers whatever
+// its sessions sent, then, if anything changed, waits once for the journal
+// before sending those answers: no client sees OK for a change that is not on
+// disk, and one fsync covers a whole round of sessions. If the journal fails,
+// the round's connections are closed without their answers.
+class ServerSala {
+public:
+    static constexpr size_t LUNGIME_MAXIMA = 1024;            // longest request line
+    static constexpr size_t LIMITA_IESIRE  = size_t(1) << 16; // unsent answers before a session is no longer read
+
+private:
+    static constexpr size_t MARIME_CITIRE = size_t(1) << 16;
+    static constexpr int ACCEPTARI_PE_RUNDA = 64;              // leave the rest of the backlog to other workers
+
+    struct Sesiune {
+        int fd;
+        TokenSesiune token;
+        bool autentificat = false;    // token belongs to this connection's session
+        std::string intrare;          // bytes after the last complete line
+        std::string iesire;           // answers not yet sent
+        size_t trimis = 0;            // bytes of iesire already sent
+        bool inRunda = false;         // queued for this round's sending phase
+        bool pauza = false;           // stopped reading (or answering) because iesire is full
+        bool citireInchisa = false;   // the peer finished sending
+        bool eroare = false;          // the socket failed; drop the session
+
+        explicit Sesiune(int fd) : fd(fd) {}
+        bool plina() const { return iesire.size() - trimis >= LIMITA_IESIRE; }
+    };
+
+    // What one pass over the ready sessions did
+    struct Runda {
+        std::vector<Sesiune*> sesiuni;   // to send to (and maybe close) after the journal
+        uint64_t cereri = 0;
+        bool modificat = false;          // some answer acknowledges a journaled change
+    };
+
+    Sala& sala;
+    unsigned fire;
+    int ascultare = -1;
+    int oprire = -1;            // eventfd, readable once opreste() was called
+    bool tcp = false;
+    std::string caleUnix;       // removed on destruction
+    std::atomic<uint64_t> numarCereri{0};
+    std::atomic<uint64_t> numarConexiuni{0};
+
+    static bool estePort(std::string_view adresa) {
+        if (adresa.empty() || adresa.size() > 5) return false;
+        for (char c : adresa)
+            if (c < '0' || c > '9') return false;
+        return true;
+    }
+
+    static bool adresaUnix(const std::string& cale, sockaddr_un& a) {
+        std::memset(&a, 0, sizeof(a));
+        a.sun_family = AF_UNIX;
+        if (cale.size() >= sizeof(a.sun_path)) return false;
+        std::memcpy(a.sun_path, cale.data(), cale.size());
+        return true;
+    }
+
+    static sockaddr_in adresaTcp(int port) {
+        sockaddr_in a{};
+        a.sin_family = AF_INET;
+        a.sin_port = htons(static_cast<uint16_t>(port));
+        a.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        return a;
+    }
+
+    // Up to a.size() arguments of one line, as views into it ("quotes" for spaces).
+    // Returns how many there are, or a.size() + 1 if there are too many.
+    template <size_t N>
+    static size_t imparte(std::string_view linie, std::array<std::string_view, N>& a) {
+        size_t n = 0, i = 0;
+        while (true) {
+            while (i < linie.size() && (linie[i] == ' ' || linie[i] == '\t' || linie[i] == '\r')) i++;
+            if (i >= linie.size()) return n;
+            if (n == N) return N + 1;
+            size_t sfarsit;
+            if (linie[i] == '"') {
+                sfarsit = linie.find('"', ++i);
+                if (sfarsit == std::string_view::npos) sfarsit = linie.size();
+                a[n++] = linie.substr(i, sfarsit - i);
+                sfarsit++;
+            } else {
+                sfarsit = i;
+                while (sfarsit < linie.size() && linie[sfarsit] != ' ' && linie[sfarsit] != '\t' &&
+                       linie[sfarsit] != '\r')
+                    sfarsit++;
+                a[n++] = linie.substr(i, sfarsit - i);
+            }
+            i = sfarsit;
+        }
+    }
+
+    static bool intreg(std::string_view text, int& valoare) {
+        if (text.empty() || text.size() > 9) return false;
+        valoare = 0;
+        for (char c : text) {
+            if (c < '0' || c > '9') return false;
+            valoare = valoare * 10 + (c - '0');
+        }
+        return true;
+    }
+
+    static constexpr const char* NUME_TIP[] = {"fara", "fitness", "piscina", "combinant"};
+
+    // A request that needs a logged-in client (sold, procura, activeaza, recomanda)
+    const char* raspundeClient(Sesiune& s, Client* client, const std::array<std::string_view, 5>& a, size_t n,
+                               Runda& runda) {
+        const std::string_view comanda = a[0];
+        if (comanda == "sold" && n == 2) {
+            Bani suma;
+            if (!Bani::parseaza(a[1], suma)) return "ERR comanda\n";
+            bool ok = static_cast<bool>(sala.adaugaSold(client, suma));
+            runda.modificat |= ok;
+            return ok ? "OK\n" : "ERR refuzat\n";
+        }
+        if (comanda == "procura" && n == 3) {
+            AbonamentValoare ab = abonamentDupaNume(a[1]);
+            Data d;
+            if (!ab || !Data::parseaza(a[2], d)) return "ERR comanda\n";
+            sala.procuraAbonament(client, std::move(ab), d);
+            runda.modificat = true;
+            return "OK\n";
+        }
+        if (comanda == "activeaza" && n == 2) {
+            Data d;
+            if (!Data::parseaza(a[1], d)) return "ERR comanda\n";
+            bool ok = static_cast<bool>(sala.activeazaAbonament(client, d));
+            runda.modificat |= ok;
+            return ok ? "OK\n" : "ERR refuzat\n";
+        }
+        if (comanda == "recomanda" && n == 1) {
+            s.iesire += "OK ";
+            s.iesire += NUME_TIP[sala.recomandare(client)];
+            return "\n";
+        }
+        return "ERR comanda\n";
+    }
+
+    // Executes one request and appends its answer to s.iesire
+    void raspunde(Sesiune& s, std::string_view linie, Runda& runda) {
+        std::array<std::string_view, 5> a;
+        const size_t n = imparte(linie, a);
+        const std::string_view comanda = n > 0 ? a[0] : std::string_view();
+        const char* raspuns = "ERR comanda\n";
+        runda.cereri++;
+
+        if (comanda == "inregistrare" && n == 5) {
+            int varsta;
+            if (intreg(a[4], varsta)) {
+                bool ok = static_cast<bool>(sala.inregistreazaClient(a[1], a[2], a[3], varsta));
+                runda.modificat |= ok;
+                raspuns = ok ? "OK\n" : "ERR refuzat\n";
+            }
+        } else if (comanda == "login" && n == 3) {
+            TokenSesiune token;
+            raspuns = "ERR refuzat\n";
+            if (sala.deschideSesiune(a[1], a[2], token)) {
+                s.token = token;
+                s.autentificat = true;
+                s.iesire += "OK ";
+                s.iesire += token.text();
+                raspuns = "\n";
+            }
+        } else if (comanda == "sesiune" && n == 2) {
+            TokenSesiune token;
+            raspuns = "ERR refuzat\n";
+            if (TokenSesiune::parseaza(a[1], token) && sala.clientSesiune(token)) {
+                s.token = token;
+                s.autentificat = true;
+                raspuns = "OK\n";
+            }
+        } else if (comanda == "logout" && n == 1) {
+            if (s.autentificat) sala.inchideSesiune(s.token);
+            s.autentificat = false;
+            raspuns = "OK\n";
+        } else if (comanda == "sold" || comanda == "procura" || comanda == "activeaza" || comanda == "recomanda") {
+            Client* client = s.autentificat ? sala.clientSesiune(s.token) : nullptr;
+            s.autentificat = client != nullptr;
+            raspuns = client ? raspundeClient(s, client, a, n, runda) : "ERR neautentificat\n";
+        }
+        s.iesire += raspuns;
+    }
+
+    // Answers every complete line in s.intrare, until iesire fills up
+    void proceseaza(Sesiune& s, Runda& runda) {
+        size_t inceput = 0;
+        while (!s.plina()) {
+            size_t sfarsit = s.intrare.find('\n', inceput);
+            if (sfarsit == std::string::npos || sfarsit - inceput > LUNGIME_MAXIMA) break;
+            raspunde(s, std::string_view(s.intrare).substr(inceput, sfarsit - inceput), runda);
+            inceput = sfarsit + 1;
+        }
+        s.intrare.erase(0, inceput);
+        if (s.intrare.size() > LUNGIME_MAXIMA && s.intrare.find('\n') > LUNGIME_MAXIMA) {
+            s.iesire += "ERR lung\n";
+            s.intrare.clear();
+            s.citireInchisa = true;
+        }
+    }
+
+    // Reads and answers until the socket is drained or the session's answers fill up
+    void citeste(Sesiune& s, char* buffer, Runda& runda) {
+        proceseaza(s, runda);
+        while (!s.citireInchisa && !s.plina()) {
+            ssize_t n = ::read(s.fd, buffer, MARIME_CITIRE);
+            if (n > 0) {
+                s.intrare.append(buffer, static_cast<size_t>(n));
+                proceseaza(s, runda);
+            } else if (n == 0) {
+                s.citireInchisa = true;
+            } else if (errno != EINTR) {
+                if (errno != EAGAIN && errno != EWOULDBLOCK) s.eroare = true;
+                break;
+            }
+        }
+        s.pauza = s.plina();
+        if (!s.inRunda) {
+            s.inRunda = true;
+            runda.sesiuni.push_back(&s);
+        }
+    }
+
+    // Sends as much of s.iesire as the socket takes; EPOLLOUT brings the rest
+    static void trimite(Sesiune& s) {
+        while (s.trimis < s.iesire.size()) {
+            ssize_t n = ::send(s.fd, s.iesire.data() + s.trimis, s.iesire.size() - s.trimis, MSG_NOSIGNAL);
+            if (n > 0) {
+                s.trimis += static_cast<size_t>(n);
+            } else if (n < 0 && errno == EINTR) {
+                continue;
+            } else {
+                if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) s.eroare = true;
+                return;
+            }
+        }
+        s.iesire.clear();
+        s.trimis = 0;
+    }
+
+    void accepta(int ep, std::vector<std::unique_ptr<Sesiune>>& sesiuni) {
+        for (int k = 0; k < ACCEPTARI_PE_RUNDA; k++) {
+            int fd = ::accept4(ascultare, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) return;
+            if (tcp) {
+                int unu = 1;
+                ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &unu, sizeof(unu));
+            }
+            epoll_event ev{};
+            ev.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+            ev.data.fd = fd;
+            if (::epoll_ctl(ep, EPOLL_CTL_ADD, fd, &ev) < 0) {
+                ::close(fd);
+                continue;
+            }
+            if (sesiuni.size() <= static_cast<size_t>(fd)) sesiuni.resize(static_cast<size_t>(fd) + 1);
+            sesiuni[fd] = std::make_unique<Sesiune>(fd);
+            numarConexiuni.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void lucreaza() {
+        int ep = ::epoll_create1(EPOLL_CLOEXEC);
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLEXCLUSIVE;
+        ev.data.fd = ascultare;
+        ::epoll_ctl(ep, EPOLL_CTL_ADD, ascultare, &ev);
+        ev.events = EPOLLIN;   // level-triggered and never read, so it wakes every worker
+        ev.data.fd = oprire;
+        ::epoll_ctl(ep, EPOLL_CTL_ADD, oprire, &ev);
+
+        std::vector<std::unique_ptr<Sesiune>> sesiuni;   // by file descriptor
+        std::vector<Sesiune*> deReluat;                  // paused sessions whose answers drained
+        std::vector<char> buffer(MARIME_CITIRE);
+        std::array<epoll_event, 256> evenimente;
+        Runda runda;
+        bool activ = true;
+
+        while (activ) {
+            int n = ::epoll_wait(ep, evenimente.data(), static_cast<int>(evenimente.size()), deReluat.empty() ? -1 : 0);
+            if (n < 0 && errno != EINTR) break;
+
+            runda.sesiuni.clear();
+            runda.cereri = 0;
+            runda.modificat = false;
+            for (Sesiune* s : deReluat) citeste(*s, buffer.data(), runda);
+            deReluat.clear();
+            for (int k = 0; k < n; k++) {
+                const int fd = evenimente[k].data.fd;
+                if (fd == oprire) {
+                    activ = false;
+                } else if (fd == ascultare) {
+                    accepta(ep, sesiuni);
+                } else if (Sesiune* s = sesiuni[fd].get()) {
+                    if (evenimente[k].events & ~EPOLLOUT) {
+                        citeste(*s, buffer.data(), runda);
+                    } else if (!s->inRunda) {
+                        s->inRunda = true;
+                        runda.sesiuni.push_back(s);
+                    }
+                }
+            }
+
+            // A journal that failed confirms nothing: those answers are never sent, the
+            // connections are dropped instead, so no client takes a lost change as done
+            if (runda.modificat && !sala.confirmaJurnal())
+                for (Sesiune* s : runda.sesiuni) s->eroare = true;
+            numarCereri.fetch_add(runda.cereri, std::memory_order_relaxed);
+            for (Sesiune* s : runda.sesiuni) {
+                s->inRunda = false;
+                if (!s->eroare) trimite(*s);
+                if (!s->eroare && s->pauza) {
+                    if (!s->plina()) deReluat.push_back(s);
+                } else if (s->eroare || (s->citireInchisa && s->iesire.empty())) {
+                    ::close(s->fd);   // also removes it from the epoll set
+                    sesiuni[s->fd].reset();
+                    numarConexiuni.fetch_sub(1, std::memory_order_relaxed);
+                }
+            }
+        }
+
+        for (std::unique_ptr<Sesiune>& s : sesiuni)
+            if (s) {
+                ::close(s->fd);
+                numarConexiuni.fetch_sub(1, std::memory_order_relaxed);
+            }
+        ::close(ep);
+    }
+
+public:
+    explicit ServerSala(Sala& sala, unsigned fire = 2)
+        : sala(sala), fire(fire ? fire : 1), oprire(::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)) {}
+
+    ~ServerSala() {
+        if (ascultare >= 0) ::close(ascultare);
+        if (oprire >= 0) ::close(oprire);
+        if (!caleUnix.empty()) ::unlink(caleUnix.c_str());
+    }
+
+    ServerSala(const ServerSala&) = delete;
+    ServerSala& operator=(const ServerSala&) = delete;
+
+    // Port 0 picks a free port (see getPort()). A stale Unix socket file is replaced.
+    bool asculta(const std::string& adresa) {
+        if (ascultare >= 0 || oprire < 0) return false;
+        tcp = estePort(adresa);
+        int fd = ::socket(tcp ? AF_INET : AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0) return false;
+        bool ok;
+        if (tcp) {
+            int unu = 1;
+            ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &unu, sizeof(unu));
+            int port = std::stoi(adresa);
+            sockaddr_in a = adresaTcp(port);
+            ok = port <= 65535 && ::bind(fd, reinterpret_cast<sockaddr*>(&a), sizeof(a)) == 0;
+        } else {
+            sockaddr_un a;
+            struct stat st;
+            if (::lstat(adresa.c_str(), &st) == 0 && S_ISSOCK(st.st_mode)) ::unlink(adresa.c_str());
+            ok = adresaUnix(adresa, a) && ::bind(fd, reinterpret_cast<sockaddr*>(&a), sizeof(a)) == 0;
+            if (ok) caleUnix = adresa;
+        }
+        if (!ok || ::listen(fd, SOMAXCONN) < 0) {
+            ::close(fd);
+            return false;
+        }
+        ascultare = fd;
+        return true;
+    }
+
+    // The TCP port actually listened on, 0 for a Unix socket
+    int getPort() const {
+        sockaddr_in a{};
+        socklen_t lungime = sizeof(a);
+        if (!tcp || ::getsockname(ascultare, reinterpret_cast<sockaddr*>(&a), &lungime) < 0) return 0;
+        return ntohs(a.sin_port);
+    }
+
+    // Serves until opreste(); the calling thread is one of the workers. Runs once.
+    void ruleaza() {
+        if (ascultare < 0) return;
+        std::vector<std::thread> lucratori;
+        for (unsigned k = 1; k < fire; k++) lucratori.emplace_back([this] { lucreaza(); });
+        lucreaza();
+        for (std::thread& t : lucratori) t.join();
+    }
+
+    // Makes ruleaza() return after the current round. Safe in a signal handler.
+    void opreste() {
+        uint64_t unu = 1;
+        ssize_t scris = ::write(oprire, &unu, sizeof(unu));
+        (void)scris;
+    }
+
+    uint64_t getNumarCereri() const { return numarCereri.load(std::memory_order_relaxed); }
+    uint64_t getNumarConexiuni() const { return numarConexiuni.load(std::memory_order_relaxed); }
+
+    // A blocking connection to a server at `adresa` (same syntax as asculta), or -1
+    static int conecteaza(const std::string& adresa) {
+        const bool prinTcp = estePort(adresa);
+        int fd = ::socket(prinTcp ? AF_INET : AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0) return -1;
+        bool ok;
+        if (prinTcp) {
+            sockaddr_in a = adresaTcp(std::stoi(adresa));
+            ok = ::connect(fd, reinterpret_cast<sockaddr*>(&a), sizeof(a)) == 0;
+            int unu = 1;
+            if (ok) ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &unu, sizeof(unu));
+        } else {
+            sockaddr_un a;
+            ok = adresaUnix(adresa, a) && ::connect(fd, reinterpret_cast<sockaddr*>(&a), sizeof(a)) == 0;
+        }
+        if (!ok) {
+            ::close(fd);
+            return -1;
+        }
+        return fd;
+    }
+};
+
+#endif // __linux__
+
+#endif // SERVERSALA_H
@@ -0,0 +1,231 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Abonament.h"
+#include "Bani.h"
+#include "Client.h"
+#include "Data.h"
+#include "FisierMapat.h"
+#include "Sala.h"
+
+// Binary snapshot of a whole Sala.
+//
+// Layout (native little-endian):
+//   Antet                         fixed header, see below
+//   InregistrareClient[n]         one fixed-size record per client
+//   string blob                   nume + telefon + parola of every client, back to back
+//
+// Fixed-size records let the loader walk the mapped file directly, without
+// parsing; the only per-client work is constructing the objects themselves.
+//
+// Since version 3, sold and pret are int64 bani.
+class Snapshot {
+public:
+    static constexpr uint32_t VERSIUNE = 3;
+
+    // Writes to `cale` atomically (temporary file + rename). The gym is locked
+    // exclusively while its records are copied, not while the file is written.
+    static bool salveaza(const Sala& sala, const std::string& cale) {
+        std::unique_lock<std::shared_mutex> blocare(sala.structura);
+        const size_t n = sala.clienti.size();
+        std::vector<InregistrareClient> inregistrari(n);
+        std::string siruri;
+
+        for (size_t i = 0; i < n; i++) {
+            const Client& c = sala.clienti[i];
+            if (c.nume.size() > UINT16_MAX || c.parola.size() > UINT16_MAX) return false;
+
+            InregistrareClient& r = inregistrari[i];
+            std::memset(&r, 0, sizeof(r));
+            r.offsetSiruri   = siruri.size();
+            r.lungimeNume    = static_cast<uint16_t>(c.nume.size());
+            r.lungimeTelefon = static_cast<uint16_t>(c.telefon.size());
+            r.lungimeParola  = static_cast<uint16_t>(c.parola.size());
+            r.varsta         = static_cast<uint8_t>(c.varsta);
+            r.sold           = c.sold.bani();
+            siruri += c.nume;
+            siruri += c.telefon;
+            siruri += c.parola;
+
+            if (const Abonament* ab = c.abonament.get()) {
+                r.tipAbonament   = c.abonament.tip();
+                r.stare          = static_cast<uint8_t>(ab->stare);
+                r.durata         = ab->durata;
+                r.pret           = ab->pret.bani();
+                r.dataProcurarii = ab->dataProcurarii.zile();
+                r.dataActivarii  = ab->dataActivarii.zile();
+                r.dataExpirarii  = ab->dataExpirarii.zile();
+            }
+        }
+
+        Antet antet;
+        std::memset(&antet, 0, sizeof(antet));
+        std::memcpy(antet.magic, MAGIC, sizeof(MAGIC));
+        antet.versiune           = VERSIUNE;
+        antet.marimeInregistrare = sizeof(InregistrareClient);
+        antet.numarClienti       = n;
+        antet.marimeSiruri       = siruri.size();
+        antet.dataCurenta        = sala.dataCurenta.zile();
+        antet.ultimaSecventa     = sala.ultimaSecventa;
+        uint64_t suma = sumaControl(reinterpret_cast<const char*>(inregistrari.data()),
+                                    n * sizeof(InregistrareClient), BAZA_SUMA);
+        antet.sumaControl = sumaControl(siruri.data(), siruri.size(), suma);
+        blocare.unlock();
+
+        const std::string temporar = cale + ".tmp";
+        FILE* f = std::fopen(temporar.c_str(), "wb");
+        if (!f) return false;
+        bool ok = std::fwrite(&antet, sizeof(antet), 1, f) == 1 &&
+                  (n == 0 || std::fwrite(inregistrari.data(), sizeof(InregistrareClient), n, f) == n) &&
+                  (siruri.empty() || std::fwrite(siruri.data(), 1, siruri.size(), f) == siruri.size()) &&
+                  std::fflush(f) == 0;
+#if !defined(_WIN32)
+        ok = ok && ::fsync(::fileno(f)) == 0;
+#endif
+        ok = std::fclose(f) == 0 && ok;
+        if (!ok || std::rename(temporar.c_str(), cale.c_str()) != 0) {
+            std::remove(temporar.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    // Loads into an empty Sala. Returns false if the file is missing, truncated,
+    // from another version or fails the checksum; the Sala is untouched then.
+    // Each balance enters the Sala's ledger as its opening entry.
+    static bool incarca(Sala& sala, const std::string& cale) {
+        std::unique_lock<std::shared_mutex> blocare(sala.structura);
+        if (!sala.clienti.empty()) return false;
+        FisierMapat fisier(cale);
+        if (!fisier.date || fisier.marime < sizeof(Antet)) return false;
+
+        Antet antet;
+        std::memcpy(&antet, fisier.date, sizeof(antet));
+        if (std::memcmp(antet.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+            antet.versiune != VERSIUNE ||
+            antet.marimeInregistrare != sizeof(InregistrareClient))
+            return false;
+
+        const uint64_t n = antet.numarClienti;
+        const uint64_t marimeInregistrari = n * sizeof(InregistrareClient);
+        if (n > (fisier.marime - sizeof(Antet)) / sizeof(InregistrareClient) ||
+            fisier.marime - sizeof(Antet) - marimeInregistrari != antet.marimeSiruri)
+            return false;
+
+        const char* zonaInregistrari = fisier.date + sizeof(Antet);
+        const char* siruri = zonaInregistrari + marimeInregistrari;
+        uint64_t suma = sumaControl(zonaInregistrari, marimeInregistrari, BAZA_SUMA);
+        if (sumaControl(siruri, antet.marimeSiruri, suma) != antet.sumaControl) return false;
+
+        // First pass only validates, so a bad file never leaves a half-loaded Sala
+        for (uint64_t i = 0; i < n; i++) {
+            InregistrareClient r;
+            std::memcpy(&r, zonaInregistrari + i * sizeof(r), sizeof(r));
+            // Lengths are checked one at a time against what is left, never summed, so a
+            // corrupt offset or length cannot wrap around and point outside the strings
+            if (r.offsetSiruri > antet.marimeSiruri) return false;
+            uint64_t ramas = antet.marimeSiruri - r.offsetSiruri;
+            if (r.lungimeNume > ramas) return false;
+            ramas -= r.lungimeNume;
+            if (r.lungimeTelefon > ramas) return false;
+            ramas -= r.lungimeTelefon;
+            uint32_t cheie;
+            if (r.lungimeParola > ramas ||
+                !cheieTelefon(std::string_view(siruri + r.offsetSiruri + r.lungimeNume, r.lungimeTelefon), cheie) ||
+                r.tipAbonament > TIP_COMBINANT || r.stare > EXPIRAT)
+                return false;
+        }
+
+        sala.indexTelefon.rezerva(n);
+        for (uint64_t i = 0; i < n; i++) {
+            InregistrareClient r;
+            std::memcpy(&r, zonaInregistrari + i * sizeof(r), sizeof(r));
+            const char* p = siruri + r.offsetSiruri;
+            std::string_view nume(p, r.lungimeNume);
+            std::string_view telefon(p + r.lungimeNume, r.lungimeTelefon);
+            std::string_view parola(p + r.lungimeNume + r.lungimeTelefon, r.lungimeParola);
+
+            uint32_t cheie = 0;
+            cheieTelefon(telefon, cheie);
+            if (!sala.indexTelefon.insereaza(cheie, static_cast<uint32_t>(sala.clienti.size())))
+                continue;   // duplicate phone: keep the first occurrence
+
+            Client& c = sala.clienti.emplace_back(nume, telefon, parola, r.varsta, &sala.memorieSiruri);
+            c.sold = Bani::dinBani(r.sold);
+            sala.registru.adauga(static_cast<uint32_t>(sala.clienti.size() - 1), MiscareSold::SOLD_INITIAL, c.sold);
+            if (r.tipAbonament != 0) {
+                c.abonament = creeazaAbonament(static_cast<TipAbonament>(r.tipAbonament), r.durata,
+                                               Bani::dinBani(r.pret));
+                Abonament* ab = c.abonament.get();
+                ab->stare          = static_cast<StareAbonament>(r.stare);
+                ab->dataProcurarii = Data::dinZile(r.dataProcurarii);
+                ab->dataActivarii  = Data::dinZile(r.dataActivarii);
+                ab->dataExpirarii  = Data::dinZile(r.dataExpirarii);
+                if (ab->esteActiv())
+                    sala.planificator.programeaza(ab->dataExpirarii,
+                                                  static_cast<uint32_t>(sala.clienti.size() - 1));
+            }
+        }
+        for (size_t i = 0; i < sala.clienti.size(); i++) sala.adaugaInColoane(sala.clienti[i]);
+        sala.dataCurenta = Data::dinZile(antet.dataCurenta);
+        sala.ultimaSecventa = antet.ultimaSecventa;
+        return true;
+    }
+
+private:
+    static constexpr char MAGIC[8] = {'F', 'Z', 'S', 'N', 'A', 'P', '\0', '\0'};
+    static constexpr uint64_t BAZA_SUMA = 14695981039346656037ull;
+
+    struct Antet {
+        char     magic[8];
+        uint32_t versiune;
+        uint32_t marimeInregistrare;
+        uint64_t numarClienti;
+        uint64_t marimeSiruri;
+        int32_t  dataCurenta;
+        uint32_t rezervat;
+        uint64_t ultimaSecventa;  // last journal record included (see Jurnal)
+        uint64_t sumaControl;
+    };
+    static_assert(sizeof(Antet) == 56);
+
+    struct InregistrareClient {
+        uint64_t offsetSiruri;
+        int64_t  sold;            // bani
+        int64_t  pret;            // bani
+        int32_t  dataProcurarii;
+        int32_t  dataActivarii;
+        int32_t  dataExpirarii;
+        int32_t  durata;
+        uint16_t lungimeNume;
+        uint16_t lungimeTelefon;
+        uint16_t lungimeParola;
+        uint8_t  varsta;
+        uint8_t  tipAbonament;    // TipAbonament
+        uint8_t  stare;
+        uint8_t  rezervat[7];
+    };
+    static_assert(sizeof(InregistrareClient) == 56);
+
+    // FNV-1a over 8-byte words: cheap enough to verify a large snapshot on every load
+    static uint64_t sumaControl(const char* p, uint64_t n, uint64_t h) {
+        uint64_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            uint64_t w;
+            std::memcpy(&w, p + i, 8);
+            h = (h ^ w) * 1099511628211ull;
+        }
+        for (; i < n; i++) h = (h ^ static_cast<unsigned char>(p[i])) * 1099511628211ull;
+        return h;
+    }
+};
+
+#endif // SNAPSHOT_H
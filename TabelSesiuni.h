@@ -0,0 +1,159 @@
+#ifndef TABELSESIUNI_H
+#define TABELSESIUNI_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Opaque handle of an open session: the table slot it lives in, the slot's
+// generation (bumped every time the slot is reused, so an old token never
+// matches a newer session) and 64 random bits that make it unguessable.
+struct TokenSesiune {
+    uint32_t slot = 0;
+    uint32_t generatie = 0;
+    uint64_t secret = 0;
+
+    bool operator==(const TokenSesiune&) const = default;
+
+    // 32 lowercase hex digits
+    std::string text() const {
+        char buf[33];
+        std::snprintf(buf, sizeof(buf), "%08x%08x%016llx", slot, generatie, static_cast<unsigned long long>(secret));
+        return buf;
+    }
+
+    static constexpr bool parseaza(std::string_view text, TokenSesiune& token) {
+        if (text.size() != 32) return false;
+        uint64_t parti[2] = {0, 0};
+        for (size_t i = 0; i < 32; i++) {
+            char c = text[i];
+            uint64_t cifra;
+            if (c >= '0' && c <= '9')      cifra = static_cast<uint64_t>(c - '0');
+            else if (c >= 'a' && c <= 'f') cifra = static_cast<uint64_t>(c - 'a' + 10);
+            else return false;
+            parti[i / 16] = parti[i / 16] << 4 | cifra;
+        }
+        token.slot = static_cast<uint32_t>(parti[0] >> 32);
+        token.generatie = static_cast<uint32_t>(parti[0]);
+        token.secret = parti[1];
+        return true;
+    }
+};
+
+// Open sessions: token -> client position, with a fixed lifetime.
+// A token names its slot directly, so resolving it is one array access and
+// two comparisons, with no hashing or password check. Expired sessions are
+// refused as soon as they are looked up, and their slots are reclaimed from a
+// min-heap of expiry times, a few at every deschide(). Like
+// PlanificatorExpirare, the heap keeps entries of sessions closed early;
+// the generation check skips them when they come due.
+// Not synchronized: Sala guards it with its own mutex.
+class TabelSesiuni {
+public:
+    using Ceas = std::chrono::steady_clock;
+
+private:
+    struct Slot {
+        uint64_t secret = 0;
+        Ceas::time_point expira;
+        uint32_t generatie = 0;
+        uint32_t pozitie = 0;
+        bool deschisa = false;
+    };
+
+    struct Expirare {
+        Ceas::time_point la;
+        uint32_t slot;
+        uint32_t generatie;
+    };
+
+    std::vector<Slot> sloturi;
+    std::vector<uint32_t> libere;
+    std::vector<Expirare> heap;
+    Ceas::duration durata;
+    std::random_device entropie;
+    size_t deschise = 0;
+
+    static bool maiTarziu(const Expirare& a, const Expirare& b) { return a.la > b.la; }
+
+    const Slot* gaseste(const TokenSesiune& token) const {
+        if (token.slot >= sloturi.size()) return nullptr;
+        const Slot& s = sloturi[token.slot];
+        return s.deschisa && s.generatie == token.generatie && s.secret == token.secret ? &s : nullptr;
+    }
+
+    void elibereaza(uint32_t slot) {
+        sloturi[slot].deschisa = false;
+        sloturi[slot].generatie++;
+        libere.push_back(slot);
+        deschise--;
+    }
+
+public:
+    explicit TabelSesiuni(Ceas::duration durata = std::chrono::minutes(30)) : durata(durata) {}
+
+    TabelSesiuni(const TabelSesiuni&) = delete;
+    TabelSesiuni& operator=(const TabelSesiuni&) = delete;
+
+    TokenSesiune deschide(uint32_t pozitie, Ceas::time_point acum = Ceas::now()) {
+        expira(acum);
+        uint32_t slot;
+        if (!libere.empty()) {
+            slot = libere.back();
+            libere.pop_back();
+        } else {
+            slot = static_cast<uint32_t>(sloturi.size());
+            sloturi.emplace_back();
+        }
+        Slot& s = sloturi[slot];
+        s.secret   = static_cast<uint64_t>(entropie()) << 32 | entropie();
+        s.expira   = acum + durata;
+        s.pozitie  = pozitie;
+        s.deschisa = true;
+        deschise++;
+        heap.push_back(Expirare{s.expira, slot, s.generatie});
+        std::push_heap(heap.begin(), heap.end(), maiTarziu);
+        return TokenSesiune{slot, s.generatie, s.secret};
+    }
+
+    // Client position of an open session, or -1 if the token is unknown, closed or expired
+    int rezolva(const TokenSesiune& token, Ceas::time_point acum = Ceas::now()) {
+        const Slot* s = gaseste(token);
+        if (!s) return -1;
+        if (s->expira <= acum) {
+            elibereaza(token.slot);
+            return -1;
+        }
+        return static_cast<int>(s->pozitie);
+    }
+
+    bool inchide(const TokenSesiune& token) {
+        if (!gaseste(token)) return false;
+        elibereaza(token.slot);
+        return true;
+    }
+
+    // Closes every session whose lifetime is over. Returns how many.
+    size_t expira(Ceas::time_point acum = Ceas::now()) {
+        size_t expirate = 0;
+        while (!heap.empty() && heap.front().la <= acum) {
+            std::pop_heap(heap.begin(), heap.end(), maiTarziu);
+            Expirare e = heap.back();
+            heap.pop_back();
+            if (sloturi[e.slot].deschisa && sloturi[e.slot].generatie == e.generatie) {
+                elibereaza(e.slot);
+                expirate++;
+            }
+        }
+        return expirate;
+    }
+
+    size_t dimensiune() const { return deschise; }
+};
+
+#endif // TABELSESIUNI_H
@@ -0,0 +1,51 @@
+#ifndef TAMPONIESIRE_H
+#define TAMPONIESIRE_H
+
+#include <cstdio>
+#include <streambuf>
+#include <vector>
+
+// Output buffer for non-interactive runs. It ignores flush requests
+// (std::endl, std::flush) and writes only when the buffer is full or on
+// destruction, so code written for the console does not pay one system
+// call per line when its output goes to a file or a pipe.
+class TamponIesire : public std::streambuf {
+private:
+    FILE* destinatie;
+    std::vector<char> buffer;
+
+    bool scrieTot() {
+        size_t n = static_cast<size_t>(pptr() - pbase());
+        bool ok = n == 0 || std::fwrite(pbase(), 1, n, destinatie) == n;
+        setp(buffer.data(), buffer.data() + buffer.size());
+        return ok;
+    }
+
+protected:
+    int overflow(int c) override {
+        if (!scrieTot()) return traits_type::eof();
+        if (c != traits_type::eof()) {
+            *pptr() = static_cast<char>(c);
+            pbump(1);
+        }
+        return traits_type::not_eof(c);
+    }
+
+    int sync() override { return 0; }
+
+public:
+    explicit TamponIesire(FILE* destinatie, size_t marime = size_t(1) << 16)
+        : destinatie(destinatie), buffer(marime) {
+        setp(buffer.data(), buffer.data() + buffer.size());
+    }
+
+    ~TamponIesire() override { goleste(); }
+
+    // Forces everything buffered so far out
+    void goleste() {
+        scrieTot();
+        std::fflush(destinatie);
+    }
+};
+
+#endif // TAMPONIESIRE_H
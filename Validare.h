@@ -0,0 +1,74 @@
+#ifndef VALIDARE_H
+#define VALIDARE_H
+
+#include <cstdint>
+#include <string_view>
+
+// Hand-written scanners for the input formats used by the gym.
+// They replace std::regex: no pattern compilation, no allocation,
+// a single pass over the characters.
+
+constexpr bool esteAnBisect(int an) {
+    return (an % 4 == 0 && an % 100 != 0) || an % 400 == 0;
+}
+
+constexpr int zileInLuna(int an, int luna) {
+    constexpr int zile[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    return (luna == 2 && esteAnBisect(an)) ? 29 : zile[luna - 1];
+}
+
+// Reads exactly n decimal digits starting at p
+constexpr bool citesteCifre(const char* p, int n, int& valoare) {
+    int v = 0;
+    for (int i = 0; i < n; i++) {
+        unsigned cifra = static_cast<unsigned char>(p[i]) - '0';
+        if (cifra > 9) return false;
+        v = v * 10 + static_cast<int>(cifra);
+    }
+    valoare = v;
+    return true;
+}
+
+// "YYYY-MM-DD" that is also a real calendar day (month 1-12, day within the month)
+constexpr bool parseazaData(std::string_view data, int& an, int& luna, int& zi) {
+    if (data.size() != 10 || data[4] != '-' || data[7] != '-') return false;
+    if (!citesteCifre(data.data(), 4, an) ||
+        !citesteCifre(data.data() + 5, 2, luna) ||
+        !citesteCifre(data.data() + 8, 2, zi))
+        return false;
+    return luna >= 1 && luna <= 12 && zi >= 1 && zi <= zileInLuna(an, luna);
+}
+
+constexpr bool dataValida(std::string_view data) {
+    int an = 0, luna = 0, zi = 0;
+    return parseazaData(data, an, luna, zi);
+}
+
+// Moldovan phone number, "+373XXXXXXXX" or "0XXXXXXXX".
+// On success cheie receives the 8 national digits, identical for both formats.
+constexpr bool cheieTelefon(std::string_view telefon, uint32_t& cheie) {
+    int start;
+    if (telefon.size() == 12 && telefon.substr(0, 4) == "+373")
+        start = 4;
+    else if (telefon.size() == 9 && telefon[0] == '0')
+        start = 1;
+    else
+        return false;
+
+    int cifre = 0;
+    if (!citesteCifre(telefon.data() + start, 8, cifre)) return false;
+    cheie = static_cast<uint32_t>(cifre);
+    return true;
+}
+
+constexpr bool telefonValid(std::string_view telefon) {
+    uint32_t cheie = 0;
+    return cheieTelefon(telefon, cheie);
+}
+
+static_assert(dataValida("2024-02-29") && !dataValida("2023-02-29"));
+static_assert(!dataValida("2024-13-01") && !dataValida("2024-1-01"));
+static_assert(telefonValid("+37369123456") && telefonValid("069123456"));
+static_assert(!telefonValid("+37469123456") && !telefonValid("69123456"));
+
+#endif // VALIDARE_H
@@ -0,0 +1,50 @@
+#ifndef VECTORIAL_H
+#define VECTORIAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Bulk arithmetic over contiguous arrays, written with the GCC/Clang vector
+// extensions. Money is integer bani, so a vector holds 64-bit integer lanes:
+// 2 with the x86-64 baseline (SSE2) or NEON, 4 with -mavx2.
+// Other compilers, or a build with FITZONE_FARA_SIMD, get the scalar loops.
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(FITZONE_FARA_SIMD)
+#define FITZONE_SIMD 1
+#if defined(__AVX2__)
+constexpr size_t LATIME_SIMD = 4;
+#else
+constexpr size_t LATIME_SIMD = 2;
+#endif
+typedef int64_t VectorIntreg __attribute__((vector_size(8 * LATIME_SIMD)));
+typedef int64_t VectorMasca  __attribute__((vector_size(8 * LATIME_SIMD)));   // all ones / zeros per lane
+typedef uint8_t VectorOcteti __attribute__((vector_size(LATIME_SIMD)));
+
+// Unaligned loads and stores of LATIME_SIMD 8-byte values (int64_t, Bani);
+// memcpy compiles to a single vector move
+inline VectorIntreg incarcaVector(const void* p) {
+    VectorIntreg v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline void stocheazaVector(void* p, VectorIntreg v) { std::memcpy(p, &v, sizeof(v)); }
+
+inline VectorOcteti incarcaOcteti(const uint8_t* p) {
+    VectorOcteti v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// Keeps the lanes of v whose mask is set, zero elsewhere
+inline VectorIntreg selecteaza(VectorMasca masca, VectorIntreg v) { return masca & v; }
+
+template <typename V>
+inline auto sumaBenzi(V v) {
+    auto suma = v[0];
+    for (size_t k = 1; k < LATIME_SIMD; k++) suma += v[k];
+    return suma;
+}
+#endif
+
+#endif // VECTORIAL_H
@@ -0,0 +1,1388 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <numeric>
+#include <random>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Afisaj.h"
+#include "Bani.h"
+#include "ExportAnalitic.h"
+#include "ImportClienti.h"
+#include "InterpretorComenzi.h"
+#include "Jurnal.h"
+#include "Metrici.h"
+#include "Sala.h"
+#include "ServerSala.h"
+#include "Snapshot.h"
+#include "TabelSesiuni.h"
+#include "TamponIesire.h"
+#include "Validare.h"
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+using namespace std;
+
+// Keeps the optimizer from discarding the measured work
+static volatile long long rezervor;
+
+// Every heap allocation made by the process, for the 'alocari' section
+static atomic<size_t> numarAlocari{0};
+
+void* operator new(size_t marime) {
+    numarAlocari.fetch_add(1, memory_order_relaxed);
+    if (void* p = malloc(marime ? marime : 1)) return p;
+    throw bad_alloc();
+}
+[[gnu::noinline]] void operator delete(void* p) noexcept { free(p); }
+[[gnu::noinline]] void operator delete(void* p, size_t) noexcept { free(p); }
+
+template <typename F>
+double nsPeOperatie(size_t operatii, F&& f) {
+    auto start = chrono::steady_clock::now();
+    f();
+    auto durata = chrono::steady_clock::now() - start;
+    return chrono::duration<double, nano>(durata).count() / static_cast<double>(operatii);
+}
+
+double secundeDe(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+// Where the timed views (afiseaza*) write: their text is formatted, then dropped
+struct BufferNul : streambuf {
+    int overflow(int c) override { return c; }
+    streamsize xsputn(const char*, streamsize n) override { return n; }
+};
+BufferNul bufferNul;
+ostream iesireNula(&bufferNul);
+
+// Synthetic members: unique phones 060000000, 060000001, ...; every third one
+// has an active subscription, every seventh a purchased one
+string telefonSintetic(size_t i) {
+    char buf[24];
+    snprintf(buf, sizeof(buf), "0%08zu", 60000000 + i);
+    return buf;
+}
+
+void populeazaSala(Sala& sala, size_t n) {
+    const Data inceput = Data::dinCalendar(2025, 1, 1);
+    for (size_t i = 0; i < n; i++) {
+        string telefon = telefonSintetic(i);
+        sala.inregistreazaClient("Client " + to_string(i), telefon, "parola" + to_string(i % 1000),
+                                 14 + static_cast<int>(i % 87));
+        if (i % 3 == 0 || i % 7 == 0) {
+            Client* c = sala(telefon);
+            sala.adaugaSold(c, 1000_lei);
+            AbonamentValoare ab;
+            switch ((i / 3) % 3) {
+                case 0:  ab = AbonamentFitness(1, 300_lei);   break;
+                case 1:  ab = AbonamentPiscina(1, 250_lei);   break;
+                default: ab = AbonamentCombinant(3, 600_lei); break;
+            }
+            sala.procuraAbonament(c, ab, inceput + static_cast<int>(i % 365));
+            if (i % 3 == 0) sala.activeazaAbonament(c, inceput + static_cast<int>(i % 365));
+        }
+    }
+}
+
+void raportMicro(const string& nume, double ns, double nsReferinta) {
+    cout << "  " << left << setw(34) << nume << right << setw(10) << fixed
+         << setprecision(1) << ns << " ns/op";
+    if (nsReferinta > 0) cout << "   x" << setprecision(1) << nsReferinta / ns;
+    cout << '\n';
+}
+
+// ======================== VALIDARE ========================
+// Old path (std::regex built on every call) vs the scanners from Validare.h
+void benchmarkValidare() {
+    const vector<string> date = {"2024-02-29", "2023-02-29", "2025-12-31", "2025-13-01",
+                                 "1999-07-15", "abcd-ef-gh", "2025-1-1",   "2030-04-31"};
+    const vector<string> telefoane = {"+37369123456", "069123456", "+37469123456", "69123456",
+                                      "079999999",    "0791234a6", "+37379000001", "0"};
+    const size_t runde = 20000;
+    const size_t operatii = runde * date.size();
+
+    cout << "\n== Validare (" << operatii << " apeluri) ==\n";
+
+    double regexDataPeApel = nsPeOperatie(operatii, [&] {
+        long long n = 0;
+        for (size_t r = 0; r < runde; r++)
+            for (const string& d : date) {
+                regex format(R"(\d{4}-\d{2}-\d{2})");
+                n += regex_match(d, format);
+            }
+        rezervor = n;
+    });
+    double regexDataStatic = nsPeOperatie(operatii, [&] {
+        static const regex format(R"(\d{4}-\d{2}-\d{2})");
+        long long n = 0;
+        for (size_t r = 0; r < runde; r++)
+            for (const string& d : date) n += regex_match(d, format);
+        rezervor = n;
+    });
+    double scanerData = nsPeOperatie(operatii, [&] {
+        long long n = 0;
+        for (size_t r = 0; r < runde; r++)
+            for (const string& d : date) n += dataValida(d);
+        rezervor = n;
+    });
+    raportMicro("data: regex construit per apel", regexDataPeApel, 0);
+    raportMicro("data: regex precompilat", regexDataStatic, regexDataPeApel);
+    raportMicro("data: scaner (+ calendar)", scanerData, regexDataPeApel);
+
+    double regexTelPeApel = nsPeOperatie(operatii, [&] {
+        long long n = 0;
+        for (size_t r = 0; r < runde; r++)
+            for (const string& t : telefoane) {
+                regex telefonRegex(R"((\+373\d{8}|0\d{8}))");
+                n += regex_match(t, telefonRegex);
+            }
+        rezervor = n;
+    });
+    double scanerTel = nsPeOperatie(operatii, [&] {
+        long long n = 0;
+        for (size_t r = 0; r < runde; r++)
+            for (const string& t : telefoane) n += telefonValid(t);
+        rezervor = n;
+    });
+    raportMicro("telefon: regex construit per apel", regexTelPeApel, 0);
+    raportMicro("telefon: scaner", scanerTel, regexTelPeApel);
+}
+
+// ======================== SNAPSHOT ========================
+// Startup from a binary snapshot vs rebuilding the gym one registration at a time
+void benchmarkSnapshot(size_t n) {
+    const string cale = "bench.snap";
+    cout << "\n== Snapshot (" << n << " clienti) ==\n";
+
+    Sala original("Bench");
+    auto start = chrono::steady_clock::now();
+    populeazaSala(original, n);
+    double secundeInregistrare = secundeDe(start);
+
+    start = chrono::steady_clock::now();
+    bool salvat = Snapshot::salveaza(original, cale);
+    double secundeSalvare = secundeDe(start);
+
+    Sala incarcata("Bench");
+    start = chrono::steady_clock::now();
+    bool incarcat = Snapshot::incarca(incarcata, cale);
+    double secundeIncarcare = secundeDe(start);
+
+    FILE* f = fopen(cale.c_str(), "rb");
+    long marime = 0;
+    if (f) {
+        fseek(f, 0, SEEK_END);
+        marime = ftell(f);
+        fclose(f);
+    }
+    remove(cale.c_str());
+
+    if (!salvat || !incarcat || incarcata.getNumarClienti() != original.getNumarClienti()) {
+        cout << "  EROARE: snapshot-ul nu a putut fi salvat/incarcat\n";
+        return;
+    }
+    cout << fixed << setprecision(3)
+         << "  inregistrare client cu client   " << setw(8) << secundeInregistrare << " s\n"
+         << "  salvare snapshot                " << setw(8) << secundeSalvare << " s ("
+         << marime / (1024 * 1024) << " MiB)\n"
+         << "  incarcare snapshot              " << setw(8) << secundeIncarcare << " s   x"
+         << setprecision(1) << secundeInregistrare / secundeIncarcare << '\n';
+}
+
+// ======================== JURNAL ========================
+// Journaled top-ups: group commit vs waiting for an fsync after every operation
+void benchmarkJurnal(size_t operatii) {
+    const string cale = "bench.wal";
+    const size_t clientiJurnal = 1000;
+    cout << "\n== Jurnal (" << operatii << " alimentari de sold) ==\n";
+
+    auto ruleaza = [&](size_t n, bool confirmaFiecare, uint64_t& sincronizari) {
+        remove(cale.c_str());
+        Sala sala("Bench");
+        populeazaSala(sala, clientiJurnal);
+        vector<Client*> clienti;
+        for (size_t i = 0; i < clientiJurnal; i++) clienti.push_back(sala(telefonSintetic(i)));
+
+        Jurnal jurnal(cale, sala.getUltimaSecventa());
+        sala.ataseazaJurnal(&jurnal);
+        auto start = chrono::steady_clock::now();
+        for (size_t i = 0; i < n; i++) {
+            sala.adaugaSold(clienti[i % clientiJurnal], 10_lei);
+            if (confirmaFiecare) sala.confirmaJurnal();
+        }
+        sala.confirmaJurnal();
+        double secunde = secundeDe(start);
+        sincronizari = jurnal.getNumarSincronizari();
+        sala.ataseazaJurnal(nullptr);
+        return static_cast<double>(n) / secunde;
+    };
+
+    uint64_t sincronizariGrup = 0, sincronizariFiecare = 0;
+    double opsGrup = ruleaza(operatii, false, sincronizariGrup);
+    size_t operatiiFiecare = operatii < 2000 ? operatii : 2000;
+    double opsFiecare = ruleaza(operatiiFiecare, true, sincronizariFiecare);
+    remove(cale.c_str());
+
+    cout << fixed << setprecision(0)
+         << "  group commit            " << setw(12) << opsGrup << " ops/s  ("
+         << sincronizariGrup << " fsync pentru " << operatii << " operatii)\n"
+         << "  fsync la fiecare op.    " << setw(12) << opsFiecare << " ops/s  ("
+         << sincronizariFiecare << " fsync pentru " << operatiiFiecare << " operatii)\n";
+}
+
+// ======================== OPERATII ========================
+// Latency of every individual call, reported as throughput and percentiles
+class Latente {
+private:
+    vector<uint64_t> ns;
+
+public:
+    explicit Latente(size_t estimare) { ns.reserve(estimare); }
+
+    template <typename F>
+    void masoara(F&& f) {
+        auto start = chrono::steady_clock::now();
+        f();
+        ns.push_back(static_cast<uint64_t>(
+            chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count()));
+    }
+
+    static void antet() {
+        cout << "  " << left << setw(22) << "operatie" << right << setw(9) << "clienti"
+             << setw(13) << "ops/s" << setw(10) << "p50 ns" << setw(10) << "p90 ns"
+             << setw(10) << "p99 ns" << setw(11) << "p99.9 ns" << setw(12) << "max ns" << '\n';
+    }
+
+    void raport(const string& operatie, size_t clienti) {
+        if (ns.empty()) return;
+        double total = static_cast<double>(accumulate(ns.begin(), ns.end(), uint64_t(0)));
+        sort(ns.begin(), ns.end());
+        auto p = [&](double q) { return ns[static_cast<size_t>(q * static_cast<double>(ns.size() - 1))]; };
+        cout << "  " << left << setw(22) << operatie << right << setw(9) << clienti
+             << setw(13) << fixed << setprecision(0) << static_cast<double>(ns.size()) * 1e9 / total
+             << setw(10) << p(0.50) << setw(10) << p(0.90) << setw(10) << p(0.99)
+             << setw(11) << p(0.999) << setw(12) << ns.back() << '\n';
+    }
+};
+
+// Every core Sala operation on a gym of n synthetic clients.
+// Lookups visit the clients in a random order so the index is not walked sequentially.
+void benchmarkOperatii(size_t n) {
+    Sala sala("Bench");
+    vector<string> telefoane(n);
+    for (size_t i = 0; i < n; i++) telefoane[i] = telefonSintetic(i);
+    vector<size_t> ordine(n);
+    iota(ordine.begin(), ordine.end(), size_t(0));
+    shuffle(ordine.begin(), ordine.end(), mt19937(42));
+    const Data inceput = Data::dinCalendar(2025, 1, 1);
+    const size_t listari = max<size_t>(1, 100000 / n);
+
+    Latente inregistrare(n), autentificare(n), oferta(n), recomandare(n), activare(n), listare(listari);
+    {
+        for (size_t i = 0; i < n; i++)
+            inregistrare.masoara([&] {
+                sala.inregistreazaClient("Client " + to_string(i), telefoane[i], "parola",
+                                         14 + static_cast<int>(i % 87));
+            });
+        for (size_t i : ordine)
+            autentificare.masoara([&] { sala.autentificare(telefoane[i], "parola"); });
+        for (size_t i : ordine)
+            oferta.masoara([&] { sala.ofertaSpeciala(telefoane[i], 10.0); });
+        for (size_t i : ordine)
+            recomandare.masoara([&] { sala.recomandaAbonament(telefoane[i], iesireNula); });
+
+        // Activation needs a purchased subscription and enough balance; prepared outside the timing
+        vector<Client*> clienti(n);
+        for (size_t i = 0; i < n; i++) {
+            clienti[i] = sala(telefoane[i]);
+            sala.adaugaSold(clienti[i], 1000_lei);
+            sala.procuraAbonament(clienti[i], AbonamentFitness(1, 300_lei), inceput);
+        }
+        for (size_t i : ordine)
+            activare.masoara([&] { sala.activeazaAbonament(clienti[i], inceput); });
+
+        for (size_t r = 0; r < listari; r++)
+            listare.masoara([&] { sala.afiseazaTotiClientii(iesireNula); });
+    }
+
+    inregistrare.raport("inregistreazaClient", n);
+    autentificare.raport("autentificare", n);
+    oferta.raport("ofertaSpeciala", n);
+    recomandare.raport("recomandaAbonament", n);
+    activare.raport("activeazaAbonament", n);
+    listare.raport("afiseazaTotiClientii", n);
+}
+
+// Copying clients (the subscription travels with each copy) and registering
+// clients that immediately buy a subscription
+void benchmarkCopiere(size_t n) {
+    const Data inceput = Data::dinCalendar(2025, 1, 1);
+    double copiere, atribuire, inregistrare;
+    {
+        vector<Client> model;
+        model.reserve(n);
+        for (size_t i = 0; i < n; i++) {
+            model.emplace_back("Client " + to_string(i), telefonSintetic(i), "parola", 30);
+            model.back().procuraAbonament(AbonamentFitness(1, 300_lei), inceput);
+        }
+
+        copiere = nsPeOperatie(n, [&] {
+            vector<Client> copie(model);
+            rezervor = static_cast<long long>(copie.size());
+        });
+        vector<Client> destinatie(n);
+        atribuire = nsPeOperatie(n, [&] {
+            for (size_t i = 0; i < n; i++) destinatie[i] = model[i];
+        });
+        inregistrare = nsPeOperatie(n, [&] {
+            Sala sala("Bench");
+            for (size_t i = 0; i < n; i++) {
+                sala.inregistreazaClient(model[i].getNume(), model[i].getTelefon(), "parola", 30);
+                sala.procuraAbonament(&sala[static_cast<int>(i)], AbonamentFitness(1, 300_lei), inceput);
+            }
+        });
+    }
+
+    cout << "\n== Copiere si inregistrare (" << n << " clienti cu abonament) ==\n";
+    raportMicro("Client(const Client&)", copiere, 0);
+    raportMicro("Client::operator=", atribuire, 0);
+    raportMicro("inregistrare + procurare", inregistrare, 0);
+}
+
+// Heap allocations per journaled registration, then password churn, a pass
+// over every client's strings and the teardown of the whole gym. Names and
+// passwords are longer than the small-string buffer. Client strings live in the
+// Sala's pool, so registering allocates nothing per client: only the growth of
+// the pool, the store, the index and the journal buffer, which is logarithmic or
+// amortized over many clients. Returns false if registration allocates more.
+bool benchmarkAlocari(size_t n) {
+    vector<string> nume(n), telefoane(n), parole(n), paroleNoi(n);
+    for (size_t i = 0; i < n; i++) {
+        nume[i] = "Client cu nume lung " + to_string(i);
+        telefoane[i] = telefonSintetic(i);
+        parole[i] = "parola-lunga-" + to_string(1000000 + i);
+        paroleNoi[i] = "parola-schimbata-" + to_string(1000000 + i);
+    }
+    const string cale = "bench_alocari.wal";
+    remove(cale.c_str());
+
+    size_t alocari;
+    double inregistrare, schimbare, parcurgere, eliberare;
+    {
+        auto sala = make_unique<Sala>("Bench");
+        Jurnal jurnal(cale);
+        sala->ataseazaJurnal(&jurnal);
+        size_t inainte = numarAlocari.load();
+        inregistrare = nsPeOperatie(n, [&] {
+            for (size_t i = 0; i < n; i++) sala->inregistreazaClient(nume[i], telefoane[i], parole[i], 30);
+        });
+        alocari = numarAlocari.load() - inainte;
+
+        // Every client changes password, in random order, so buffers are freed and reused
+        vector<size_t> ordine(n);
+        iota(ordine.begin(), ordine.end(), size_t(0));
+        shuffle(ordine.begin(), ordine.end(), mt19937(7));
+        schimbare = nsPeOperatie(n, [&] {
+            for (size_t i : ordine)
+                sala->schimbaParola(&(*sala)[static_cast<int>(i)], parole[i], paroleNoi[i]);
+        });
+        jurnal.sincronizeaza();
+        sala->ataseazaJurnal(nullptr);
+
+        // Full comparisons: the candidate differs from every password in its last character
+        string candidat = paroleNoi[0];
+        candidat.back() = '#';
+        parcurgere = nsPeOperatie(n, [&] {
+            long long gasite = 0;
+            for (size_t i = 0; i < n; i++) gasite += (*sala)[static_cast<int>(i)].verificaParola(candidat);
+            rezervor = gasite;
+        });
+        eliberare = nsPeOperatie(n, [&] { sala.reset(); });
+    }
+    remove(cale.c_str());
+
+    const double limita = 0.01;   // growth allocations per client, amortized
+    double perClient = static_cast<double>(alocari) / static_cast<double>(n);
+    bool ok = perClient <= limita || alocari <= 256;
+    cout << "\n== Alocari si siruri (" << n << " clienti, cu jurnal) ==\n";
+    cout << "  alocari heap per inregistrare     " << fixed << setprecision(3) << setw(8) << perClient
+         << "   (total " << alocari << ")\n";
+    raportMicro("inregistrare", inregistrare, 0);
+    raportMicro("schimbare parola", schimbare, 0);
+    raportMicro("parcurgere parole", parcurgere, 0);
+    raportMicro("distrugere Sala", eliberare, 0);
+    cout << "  " << (ok ? "OK" : "ESEC: inregistrarea aloca pentru fiecare client") << '\n';
+    return ok;
+}
+
+// "Total balance of active Combinant members aged 30+": walking the Client
+// objects versus scanning the columnar copy
+void benchmarkColoane(size_t n) {
+    Sala sala("Bench");
+    populeazaSala(sala, n);
+    const FiltruClienti filtru{.tip = TIP_COMBINANT, .stare = ACTIV, .varstaMin = 30};
+    const size_t repetari = max<size_t>(1, 20000000 / n);
+
+    Bani sumaObiecte, sumaColoane;
+    double obiecte = nsPeOperatie(n * repetari, [&] {
+        for (size_t r = 0; r < repetari; r++) {
+            Bani suma;
+            for (int i = 0; i < static_cast<int>(n); i++) {
+                const Client& c = sala[i];
+                const Abonament* ab = c.getAbonament();
+                if (ab && c.getTipAbonament() == TIP_COMBINANT && ab->getStare() == ACTIV && c.getVarsta() >= 30)
+                    suma += c.getSold();
+            }
+            sumaObiecte = suma;
+        }
+    });
+    double coloane = nsPeOperatie(n * repetari, [&] {
+        for (size_t r = 0; r < repetari; r++) sumaColoane = sala.soldTotal(filtru);
+    });
+    double numarare = nsPeOperatie(n * repetari, [&] {
+        size_t total = 0;
+        for (size_t r = 0; r < repetari; r++) total += sala.numaraClienti(filtru);
+        rezervor = static_cast<long long>(total);
+    });
+
+    cout << "\n== Agregare (" << n << " clienti): sold total Combinant ACTIV, 30+ ani ==\n";
+    raportMicro("obiecte Client", obiecte, obiecte);
+    raportMicro("coloane, sold total", coloane, obiecte);
+    raportMicro("coloane, numarare", numarare, obiecte);
+    cout << "  rezultat: " << sumaColoane << " MDL ("
+         << (sumaColoane == sumaObiecte ? "identic" : "DIFERIT") << ")\n";
+}
+
+// Chain-wide promotion on every active member: one ofertaSpeciala per client
+// versus the vectorized bulk bonus, and per-client virtual discount versus the
+// discount kernel over the price column
+void benchmarkBonus(size_t n) {
+    Sala sala("Bench");
+    populeazaSala(sala, n);
+    const FiltruClienti activi{.stare = ACTIV};
+    vector<string> telefoane;
+    for (size_t i = 0; i < n; i++) {
+        const Abonament* ab = sala[static_cast<int>(i)].getAbonament();
+        if (ab && ab->esteActiv()) telefoane.push_back(telefonSintetic(i));
+    }
+
+    double unul, grup, virtual_, kernel;
+    Bani totalVirtual, totalKernel;
+    {
+        auto start = chrono::steady_clock::now();
+        for (const string& t : telefoane) sala.ofertaSpeciala(t, 10.0);
+        unul = secundeDe(start);
+        start = chrono::steady_clock::now();
+        sala.bonusGrup(activi, 10_lei);
+        grup = secundeDe(start);
+    }
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < n; i++) {
+        const Abonament* ab = sala[static_cast<int>(i)].getAbonament();
+        if (ab && ab->esteActiv()) totalVirtual += ab->calculeazaPretDiscount(20.0);
+    }
+    virtual_ = secundeDe(start);
+    vector<Bani> preturi;
+    start = chrono::steady_clock::now();
+    totalKernel = sala.preturiCuDiscount(activi, 20.0, preturi);
+    kernel = secundeDe(start);
+
+    cout << "\n== Promotie pe " << telefoane.size() << " membri activi din " << n << " ==\n" << fixed
+         << setprecision(2)
+         << "  bonus, ofertaSpeciala per client   " << setw(9) << unul * 1e3 << " ms\n"
+         << "  bonus, Sala::bonusGrup             " << setw(9) << grup * 1e3 << " ms   x" << setprecision(1)
+         << unul / grup << setprecision(2) << "\n"
+         << "  discount, virtual per client       " << setw(9) << virtual_ * 1e3 << " ms\n"
+         << "  discount, Sala::preturiCuDiscount  " << setw(9) << kernel * 1e3 << " ms   x" << setprecision(1)
+         << virtual_ / kernel << "\n"
+         << "  total cu discount: " << totalKernel << " MDL ("
+         << (totalKernel == totalVirtual ? "identic" : "DIFERIT") << ")\n";
+}
+
+// Balance ledger: reconciling every client against its history on one thread
+// and on all of them, catching a balance edited behind the gym's back, and the
+// drift the same top-ups would accumulate as doubles
+bool benchmarkRegistru(size_t n) {
+    Sala sala("Bench");
+    populeazaSala(sala, n);
+    {
+        sala.bonusGrup(FiltruClienti{.stare = ACTIV}, 10_lei);
+        for (size_t i = 0; i < n; i += 5) sala.ofertaSpeciala(telefonSintetic(i), 2.5);
+    }
+    const unsigned fire = max(1u, thread::hardware_concurrency());
+
+    RaportReconciliere unu, toate;
+    double secundeUnu = nsPeOperatie(1, [&] { unu = sala.reconciliazaSolduri(1); }) / 1e9;
+    double secundeToate = nsPeOperatie(1, [&] { toate = sala.reconciliazaSolduri(fire); }) / 1e9;
+
+    // Edited through operator[]: neither journaled nor in the ledger
+    sala[static_cast<int>(n / 2)] += 1_bani;
+    RaportReconciliere alterat = sala.reconciliazaSolduri();
+    bool detectat = alterat.neconcordante.size() == 1 && alterat.neconcordante[0] == n / 2;
+
+    const size_t alimentari = 10000000;
+    double dublu = 0.0;
+    Bani exact;
+    for (size_t k = 0; k < alimentari; k++) {
+        dublu += 0.10;
+        exact += 10_bani;
+    }
+
+    bool ok = unu.ok() && toate.ok() && toate.neconcordante == unu.neconcordante && detectat;
+    cout << "\n== Registru sold (" << n << " clienti, " << unu.miscari << " miscari) ==\n" << fixed
+         << setprecision(2)
+         << "  reconciliere, 1 fir               " << setw(9) << secundeUnu * 1e3 << " ms\n"
+         << "  reconciliere, " << setw(2) << fire << " fire             " << setw(9) << secundeToate * 1e3
+         << " ms   x" << setprecision(1) << secundeUnu / secundeToate << '\n'
+         << "  sold total " << toate.totalSolduri << " MDL, registru " << toate.totalRegistru << " MDL\n"
+         << "  " << alimentari << " x 0.10 MDL: double " << setprecision(6) << dublu << ", Bani " << exact << '\n'
+         << "  " << (ok ? "OK" : "ESEC: reconcilierea nu corespunde") << '\n';
+    return ok;
+}
+
+// Several front desks on one gym: each thread serves random clients with a mix
+// of 50% lookups, 30% logins and 20% top-ups. Afterwards every balance must
+// still match the ledger and the total must have grown by exactly what was added.
+bool benchmarkConcurent(size_t n) {
+    Sala sala("Bench");
+    populeazaSala(sala, n);
+    vector<string> telefoane(n);
+    for (size_t i = 0; i < n; i++) telefoane[i] = telefonSintetic(i);
+    const size_t operatiiPeFir = 200000;
+    const unsigned maxFire = max(4u, thread::hardware_concurrency());
+
+    cout << "\n== Concurent (" << n << " clienti, " << thread::hardware_concurrency() << " nuclee) ==\n";
+    double referinta = 0;
+    bool ok = true;
+    for (unsigned fire = 1; fire <= maxFire; fire *= 2) {
+        const Bani inainte = sala.soldTotal(FiltruClienti{});
+        vector<Bani> adaugat(fire);
+        vector<long long> gasiti(fire);
+        double secunde;
+        {
+            auto start = chrono::steady_clock::now();
+            vector<thread> lucratori;
+            for (unsigned k = 0; k < fire; k++)
+                lucratori.emplace_back([&, k] {
+                    mt19937_64 aleator(k + 1);
+                    for (size_t op = 0; op < operatiiPeFir; op++) {
+                        size_t i = aleator() % n;
+                        unsigned tip = static_cast<unsigned>(aleator() % 10);
+                        if (tip < 5) {
+                            gasiti[k] += sala(telefoane[i]) != nullptr;
+                        } else if (tip < 8) {
+                            sala.autentificare(telefoane[i], "parola" + to_string(i % 1000));
+                        } else if (sala.adaugaSold(sala(telefoane[i]), 1_bani)) {
+                            adaugat[k] += 1_bani;
+                        }
+                    }
+                });
+            for (thread& t : lucratori) t.join();
+            secunde = secundeDe(start);
+        }
+        rezervor = accumulate(gasiti.begin(), gasiti.end(), 0LL);
+        Bani total = inainte;
+        for (Bani b : adaugat) total += b;
+        ok = ok && sala.soldTotal(FiltruClienti{}) == total && sala.reconciliazaSolduri().ok();
+
+        double opsPeSecunda = static_cast<double>(fire * operatiiPeFir) / secunde;
+        if (fire == 1) referinta = opsPeSecunda;
+        cout << "  " << setw(2) << fire << " fire  " << setw(12) << fixed << setprecision(0) << opsPeSecunda
+             << " ops/s   x" << setprecision(2) << opsPeSecunda / referinta << '\n';
+    }
+    cout << "  " << (ok ? "OK" : "ESEC: soldurile nu corespund dupa rularea concurenta") << '\n';
+    return ok;
+}
+
+// ======================== RECOMANDARI ========================
+// The compiled rule table: one recommendation per call through a Client, then
+// every client in one pass over the columns. Both must agree with the rules
+// evaluated one by one, and a rule set that leaves members uncovered is refused.
+bool benchmarkRecomandari(size_t n) {
+    Sala sala("Bench");
+    populeazaSala(sala, n);
+    vector<Client*> clienti(n);
+    for (size_t i = 0; i < n; i++) clienti[i] = &sala[static_cast<int>(i)];
+    vector<uint8_t> toti;
+    array<size_t, MotorRecomandari::NUMAR_TIPURI> numar{};
+
+    double nsUnul = nsPeOperatie(n, [&] {
+        long long suma = 0;
+        for (size_t i = 0; i < n; i++) suma += sala.recomandare(clienti[i]);
+        rezervor = suma;
+    });
+    double nsToti = nsPeOperatie(n, [&] { numar = sala.recomandariToti(toti); });
+
+    const vector<RegulaRecomandare> reguli = MotorRecomandari::reguliImplicite();
+    bool ok = toti.size() == n && numar[FARA_ABONAMENT] == 0;
+    for (size_t i = 0; i < n && ok; i++) {
+        const Client& c = *clienti[i];
+        int nivel = nivelDinStare(c.getAbonament() ? c.getAbonament()->getStare() : NEPROCURAT);
+        auto regula = find_if(reguli.begin(), reguli.end(),
+                              [&](const RegulaRecomandare& r) { return r.potriveste(c.getVarsta(), nivel, c.getTipAbonament()); });
+        ok = regula != reguli.end() && toti[i] == regula->recomandat && sala.recomandare(&c) == regula->recomandat;
+    }
+    try {
+        MotorRecomandari incomplet({{.varstaMax = 17, .recomandat = TIP_PISCINA, .motiv = "doar tineri"}});
+        ok = false;
+    } catch (const invalid_argument&) {
+    }
+
+    cout << "\n== Recomandari (" << n << " clienti, " << reguli.size() << " reguli) ==\n";
+    raportMicro("per client (Sala::recomandare)", nsUnul, nsUnul);
+    raportMicro("toti, din coloane", nsToti, nsUnul);
+    cout << "  fitness " << numar[TIP_FITNESS] << ", piscina " << numar[TIP_PISCINA] << ", combinant "
+         << numar[TIP_COMBINANT] << '\n';
+    cout << "  " << (ok ? "OK" : "ESEC: recomandarile difera de reguli") << '\n';
+    return ok;
+}
+
+// ======================== INDEXURI ========================
+// Segment queries answered from the secondary index against a scan of the
+// columns, once the clock has expired part of the subscriptions. Both must find
+// the same clients, and the index must still match the columns for every type
+// and state after more purchases, activations and expiries.
+bool benchmarkIndexuri(size_t n) {
+    Sala sala("Bench");
+    populeazaSala(sala, n);
+    sala.avanseazaData(Data::dinCalendar(2025, 6, 1));
+
+    struct Interogare {
+        const char* nume;
+        FiltruClienti filtru;
+    };
+    const Interogare interogari[] = {
+        {"Piscina EXPIRAT, 14-18 ani", {.tip = TIP_PISCINA, .stare = EXPIRAT, .varstaMin = 14, .varstaMax = 18}},
+        {"Combinant ACTIV, 30-40 ani", {.tip = TIP_COMBINANT, .stare = ACTIV, .varstaMin = 30, .varstaMax = 40}},
+        {"PROCURAT, 60+ ani", {.stare = PROCURAT, .varstaMin = 60}},
+        {"toti, pana la 50 ani", {.varstaMax = 50}},
+    };
+    const int repetari = 5;
+    bool ok = true;
+    cout << "\n== Indexuri secundare (" << n << " clienti) ==\n" << fixed;
+    for (const Interogare& q : interogari) {
+        vector<uint32_t> dinIndex, dinScanare;
+        double nsIndex = nsPeOperatie(repetari, [&] {
+            for (int r = 0; r < repetari; r++) dinIndex = sala.cautaClienti(q.filtru);
+        });
+        double nsScanare = nsPeOperatie(repetari, [&] {
+            for (int r = 0; r < repetari; r++) {
+                dinScanare.clear();
+                sala.getColoane().pentruFiecare(q.filtru, [&](size_t i) { dinScanare.push_back(static_cast<uint32_t>(i)); });
+            }
+        });
+        sort(dinIndex.begin(), dinIndex.end());
+        ok = ok && dinIndex == dinScanare && sala.numaraClienti(q.filtru) == dinScanare.size();
+        cout << "  " << left << setw(28) << q.nume << right << setw(9) << dinScanare.size() << " clienti   index "
+             << setw(9) << setprecision(1) << nsIndex / 1e3 << " us   scanare " << setw(9) << nsScanare / 1e3
+             << " us   x" << nsScanare / nsIndex << '\n';
+    }
+
+    // Churn: every fifth client buys again and activates, then the clock moves on
+    const Data ziua = Data::dinCalendar(2025, 6, 1);
+    for (size_t i = 0; i < n; i += 5) {
+        Client* c = &sala[static_cast<int>(i)];
+        sala.adaugaSold(c, 600_lei);
+        AbonamentValoare ab;
+        if (i % 2) ab = AbonamentPiscina(1, 250_lei);
+        else       ab = AbonamentCombinant(3, 600_lei);
+        sala.procuraAbonament(c, ab, ziua);
+        if (i % 10 == 0) sala.activeazaAbonament(c, ziua);
+    }
+    sala.avanseazaData(Data::dinCalendar(2025, 8, 1));
+    for (int tip = FARA_ABONAMENT; tip <= TIP_COMBINANT; tip++)
+        for (int stare = NEPROCURAT; stare <= EXPIRAT; stare++) {
+            FiltruClienti filtru{.tip = tip, .stare = stare};
+            ok = ok && sala.numaraClienti(filtru) == sala.getColoane().numara(filtru);
+        }
+    ok = ok && sala.getIndexSecundar().dimensiune() == n;
+    cout << "  " << (ok ? "OK" : "ESEC: indexul difera de coloane") << '\n';
+    return ok;
+}
+
+// ======================== INTERVALE ========================
+// "Who is active on day D", "who was active at some point of a month" and the
+// daily active count over a year, from the interval index against a pass over
+// every client's subscription dates. Both must agree before and after a wave of
+// new purchases and activations bigger than what the index defers to a rebuild.
+bool benchmarkIntervale(size_t n) {
+    Sala sala("Bench");
+    populeazaSala(sala, n);
+
+    // The reference: every client's current period, read from its subscription
+    auto scanare = [&](Data de, Data pana, vector<uint32_t>& pozitii) {
+        pozitii.clear();
+        for (int i = 0; i < sala.getNumarClienti(); i++) {
+            const Abonament* ab = sala[i].getAbonament();
+            if (!ab || !ab->getDataActivarii().esteDefinita()) continue;
+            if (ab->getDataActivarii() <= pana && de < ab->getDataExpirarii())
+                pozitii.push_back(static_cast<uint32_t>(i));
+        }
+    };
+    auto peZi = [&](Data de, Data pana) {
+        vector<uint32_t> numar(static_cast<size_t>(pana - de) + 1, 0);
+        for (int i = 0; i < sala.getNumarClienti(); i++) {
+            const Abonament* ab = sala[i].getAbonament();
+            if (!ab || !ab->getDataActivarii().esteDefinita()) continue;
+            for (size_t d = 0; d < numar.size(); d++) {
+                const Data zi = de + static_cast<int>(d);
+                numar[d] += ab->getDataActivarii() <= zi && zi < ab->getDataExpirarii();
+            }
+        }
+        return numar;
+    };
+
+    const int repetari = 5;
+    bool ok = true;
+    cout << "\n== Index de intervale (" << n << " clienti) ==\n" << fixed;
+    auto compara = [&](const char* nume, Data de, Data pana) {
+        vector<uint32_t> dinIndex, dinScanare;
+        double nsIndex = nsPeOperatie(repetari, [&] {
+            for (int r = 0; r < repetari; r++) dinIndex = de == pana ? sala.activiLa(de) : sala.activiIntre(de, pana);
+        });
+        double nsScanare = nsPeOperatie(repetari, [&] {
+            for (int r = 0; r < repetari; r++) scanare(de, pana, dinScanare);
+        });
+        sort(dinIndex.begin(), dinIndex.end());
+        ok = ok && dinIndex == dinScanare;
+        cout << "  " << left << setw(28) << nume << right << setw(9) << dinScanare.size() << " clienti   index "
+             << setw(9) << setprecision(1) << nsIndex / 1e3 << " us   scanare " << setw(9) << nsScanare / 1e3
+             << " us   x" << nsScanare / nsIndex << '\n';
+    };
+    auto interogari = [&] {
+        // The first query after many changes rebuilds the tree; the timings below exclude it
+        double msReconstruire = nsPeOperatie(1, [&] { rezervor = static_cast<long long>(sala.activiLa(Data()).size()); }) / 1e6;
+        cout << "  " << left << setw(28) << "prima interogare" << right << setw(9) << setprecision(1)
+             << msReconstruire << " ms (reconstruieste arborele)\n";
+        compara("activi la 2025-01-15", Data::dinCalendar(2025, 1, 15), Data::dinCalendar(2025, 1, 15));
+        compara("activi la 2025-07-01", Data::dinCalendar(2025, 7, 1), Data::dinCalendar(2025, 7, 1));
+        compara("activi in martie 2025", Data::dinCalendar(2025, 3, 1), Data::dinCalendar(2025, 3, 31));
+        compara("activi la 2024-12-31", Data::dinCalendar(2024, 12, 31), Data::dinCalendar(2024, 12, 31));
+
+        const Data de = Data::dinCalendar(2025, 1, 1), pana = Data::dinCalendar(2025, 12, 31);
+        vector<uint32_t> dinIndex;
+        double msIndex = nsPeOperatie(1, [&] { dinIndex = sala.activiPeZi(de, pana); }) / 1e6;
+        vector<uint32_t> dinScanare;
+        double msScanare = nsPeOperatie(1, [&] { dinScanare = peZi(de, pana); }) / 1e6;
+        ok = ok && dinIndex == dinScanare;
+        cout << "  " << left << setw(28) << "activi pe zi, 365 zile" << right << setw(9) << dinIndex.size()
+             << " zile      index " << setw(9) << setprecision(1) << msIndex << " ms   zi cu zi "
+             << setw(9) << msScanare << " ms   x" << msScanare / msIndex << '\n';
+    };
+    interogari();
+
+    // Churn: every fourth client buys again and half of them activate right away
+    const Data ziua = Data::dinCalendar(2025, 6, 1);
+    for (size_t i = 0; i < n; i += 4) {
+        Client* c = &sala[static_cast<int>(i)];
+        sala.adaugaSold(c, 600_lei);
+        sala.procuraAbonament(c, AbonamentFitness(1, 300_lei), ziua);
+        if (i % 8 == 0) sala.activeazaAbonament(c, ziua + static_cast<int>(i % 30));
+    }
+    cout << "  dupa " << (n + 3) / 4 << " procurari noi:\n";
+    interogari();
+    // A few changes stay out of the tree and are checked one by one
+    size_t activari = 0;
+    for (size_t i = 1; i < n && i < 4000; i += 8, activari++) {
+        Client* c = &sala[static_cast<int>(i)];
+        sala.adaugaSold(c, 300_lei);
+        sala.procuraAbonament(c, AbonamentFitness(1, 300_lei), ziua);
+        sala.activeazaAbonament(c, ziua + 1);
+    }
+    cout << "  dupa " << activari << " activari, fara reconstruire:\n";
+    compara("activi la 2025-06-15", Data::dinCalendar(2025, 6, 15), Data::dinCalendar(2025, 6, 15));
+    sala.avanseazaData(Data::dinCalendar(2025, 9, 1));
+    ok = ok && sala.activiPeZi(Data::dinCalendar(2025, 1, 1), Data::dinCalendar(2025, 12, 31)) ==
+                   peZi(Data::dinCalendar(2025, 1, 1), Data::dinCalendar(2025, 12, 31));
+    cout << "  " << (ok ? "OK" : "ESEC: indexul de intervale difera de abonamente") << '\n';
+    return ok;
+}
+
+// ======================== SESIUNI ========================
+// A request that logs in again vs one that presents a session token, then the
+// session lifetime on a simulated clock: a token works until it expires, is
+// refused afterwards, and its slot is reused under a new generation.
+bool benchmarkSesiuni(size_t n) {
+    Sala sala("Bench");
+    populeazaSala(sala, n);
+    const size_t deschise = min<size_t>(n, 100000), operatii = 1000000;
+    vector<string> telefoane(deschise), parole(deschise);
+    vector<TokenSesiune> tokenuri(deschise);
+    bool ok = true;
+    double nsLogin, nsToken;
+    {
+        for (size_t i = 0; i < deschise; i++) {
+            telefoane[i] = telefonSintetic(i);
+            parole[i] = "parola" + to_string(i % 1000);
+            ok = sala.deschideSesiune(telefoane[i], parole[i], tokenuri[i]) && ok;
+        }
+        nsLogin = nsPeOperatie(operatii, [&] {
+            long long gasiti = 0;
+            for (size_t k = 0; k < operatii; k++) {
+                size_t i = (k * 7919) % deschise;
+                gasiti += sala.autentificare(telefoane[i], parole[i]) != nullptr;
+            }
+            rezervor = gasiti;
+        });
+        nsToken = nsPeOperatie(operatii, [&] {
+            long long gasiti = 0;
+            for (size_t k = 0; k < operatii; k++) gasiti += sala.clientSesiune(tokenuri[(k * 7919) % deschise]) != nullptr;
+            rezervor = gasiti;
+        });
+    }
+    for (size_t i = 0; i < deschise; i++) ok = ok && sala.clientSesiune(tokenuri[i]) == sala(telefoane[i]);
+    ok = ok && sala.inchideSesiune(tokenuri[0]) && !sala.clientSesiune(tokenuri[0]) &&
+         sala.getNumarSesiuni() == deschise - 1;
+
+    TabelSesiuni tabel(chrono::seconds(60));
+    const auto t0 = TabelSesiuni::Ceas::now();
+    vector<TokenSesiune> scurte;
+    for (uint32_t i = 0; i < 1000; i++) scurte.push_back(tabel.deschide(i, t0 + chrono::milliseconds(i)));
+    ok = ok && tabel.rezolva(scurte[999], t0 + chrono::seconds(59)) == 999;
+    ok = ok && tabel.rezolva(scurte[0], t0 + chrono::seconds(60)) == -1;   // refused on sight
+    ok = ok && tabel.expira(t0 + chrono::seconds(61)) == 999 && tabel.dimensiune() == 0;
+    TokenSesiune nou = tabel.deschide(7, t0 + chrono::seconds(61)), citit;
+    ok = ok && nou.slot < 1000 && tabel.rezolva(scurte[nou.slot], t0 + chrono::seconds(61)) == -1 &&
+         tabel.rezolva(nou, t0 + chrono::seconds(61)) == 7;
+    ok = ok && TokenSesiune::parseaza(nou.text(), citit) && citit == nou && !TokenSesiune::parseaza("xyz", citit);
+
+    cout << "\n== Sesiuni (" << n << " clienti, " << deschise << " sesiuni) ==\n";
+    raportMicro("autentificare cu parola", nsLogin, nsLogin);
+    raportMicro("token de sesiune", nsToken, nsLogin);
+    cout << "  " << (ok ? "OK" : "ESEC: tokenuri rezolvate gresit sau expirare incorecta") << '\n';
+    return ok;
+}
+
+#if defined(__linux__)
+// ======================== IMPORT ========================
+// Migrating n members from a CSV file: registering them one at a time (with
+// their top-up, purchase and activation) versus the bulk import on one thread
+// and on all of them. Every 100th row has a bad phone and every 100th repeats an
+// earlier one; both must be rejected to the rejects file. Replaying the journal
+// of an import must rebuild the same members and balances.
+bool benchmarkImport(size_t n) {
+    const string cale = "bench_import.csv", caleRespinse = "bench_respinse.csv", caleJurnal = "bench_import.wal";
+    static const char* const abonamente[] = {"fitness", "piscina", "combinant"};
+    size_t asteptatRespinsi = 0;
+    {
+        string csv = "nume,telefon,parola,varsta,sold,abonament,data_procurarii,data_activarii\n";
+        char rand[160];
+        for (size_t i = 0; i < n; i++) {
+            string telefon = i % 100 == 99 ? "12345" : i % 100 == 98 ? telefonSintetic(i - 50) : telefonSintetic(i);
+            asteptatRespinsi += i % 100 >= 98;
+            int lungime = snprintf(rand, sizeof(rand), "\"Client %zu\",%s,parola%zu,%zu,%zu.%02zu", i, telefon.c_str(),
+                                   i % 1000, 14 + i % 87, i % 2000, i % 100);
+            if (i % 3 == 0)
+                lungime += snprintf(rand + lungime, sizeof(rand) - lungime, ",%s,2025-01-%02zu,%s",
+                                    abonamente[(i / 3) % 3], 1 + i % 28, i % 2 == 0 ? "2025-02-01" : "");
+            csv.append(rand, static_cast<size_t>(lungime));
+            csv += '\n';
+        }
+        FILE* f = fopen(cale.c_str(), "wb");
+        if (!f) return false;
+        fwrite(csv.data(), 1, csv.size(), f);
+        fclose(f);
+    }
+
+    const size_t nRand = min<size_t>(n, 200000);
+    double secundeRand = 0;
+    {
+        Sala sala("Bench");
+        auto start = chrono::steady_clock::now();
+        populeazaSala(sala, nRand);
+        secundeRand = secundeDe(start);
+    }
+
+    const unsigned fire = max(1u, thread::hardware_concurrency());
+    auto importa = [&](Sala& sala, unsigned k, RaportImport& raport) {
+        auto start = chrono::steady_clock::now();
+        raport = ImportClienti::importa(sala, cale, caleRespinse, k);
+        return secundeDe(start);
+    };
+    RaportImport unu, toate, jurnalizat;
+    double secundeUnu, secundeToate, secundeJurnal;
+    {
+        Sala sala("Bench");
+        secundeUnu = importa(sala, 1, unu);
+    }
+    {
+        Sala sala("Bench");
+        secundeToate = importa(sala, fire, toate);
+    }
+    Sala importata("Bench");
+    {
+        remove(caleJurnal.c_str());
+        Jurnal j(caleJurnal);
+        importata.ataseazaJurnal(&j);
+        secundeJurnal = importa(importata, fire, jurnalizat);
+        j.sincronizeaza();
+        importata.ataseazaJurnal(nullptr);
+    }
+    Sala redata("Bench");
+    Jurnal::reda(caleJurnal, 0, [&](const OperatieJurnal& op) { redata.aplicaOperatie(op); });
+
+    size_t liniiRespinse = 0;
+    if (FILE* f = fopen(caleRespinse.c_str(), "rb")) {
+        for (int c; (c = fgetc(f)) != EOF;) liniiRespinse += c == '\n';
+        fclose(f);
+    }
+    remove(cale.c_str());
+    remove(caleRespinse.c_str());
+    remove(caleJurnal.c_str());
+
+    RaportReconciliere original = importata.reconciliazaSolduri(), replay = redata.reconciliazaSolduri();
+    bool ok = unu.linii == n && unu.respinsi == asteptatRespinsi && unu.importati == n - asteptatRespinsi &&
+              toate.importati == unu.importati && jurnalizat.importati == unu.importati &&
+              liniiRespinse == jurnalizat.respinsi && original.ok() && replay.ok() &&
+              redata.getNumarClienti() == importata.getNumarClienti() && replay.totalSolduri == original.totalSolduri;
+
+    const double referinta = nRand / secundeRand;
+    auto linie = [&](const string& nume, double secunde) {
+        cout << "  " << left << setw(30) << nume << right << setw(10) << setprecision(0) << n / secunde
+             << " randuri/s   x" << setprecision(1) << n / secunde / referinta << "   (" << n / secunde * 60 / 1e6
+             << " milioane/minut)\n";
+    };
+    cout << "\n== Import CSV (" << n << " randuri, " << toate.respinsi << " respinse) ==\n" << fixed
+         << "  " << left << setw(30) << "client cu client (" + to_string(nRand) + ")" << right << setw(10)
+         << setprecision(0) << referinta << " randuri/s\n";
+    linie("import, 1 fir", secundeUnu);
+    linie("import, " + to_string(fire) + " fire", secundeToate);
+    linie("import, " + to_string(fire) + " fire, jurnalizat", secundeJurnal);
+    cout << "  " << (ok ? "OK" : "ESEC: importul sau reluarea jurnalului difera") << '\n';
+    return ok;
+}
+
+// ======================== EXPORT ========================
+// Nightly dump for analytics: every profile printed as text (the only output
+// so far) versus the columnar export with fixed-width and compressed columns.
+// Reading the compressed file back must give every member exactly as in the gym.
+bool benchmarkExport(size_t n) {
+    const string cale = "bench_export.fzc";
+    Sala sala("Bench");
+    populeazaSala(sala, n);
+
+    stringbuf text;
+    auto start = chrono::steady_clock::now();
+    {
+        ostream os(&text);
+        for (size_t i = 0; i < n; i++) sala.afiseazaProfil(&sala[static_cast<int>(i)], os);
+    }
+    double secundeText = secundeDe(start);
+    const double octetiText = static_cast<double>(text.str().size());
+
+    auto scrie = [&](bool compresie, double& secunde) {
+        OptiuniExport optiuni;
+        optiuni.compresie = compresie;
+        auto start = chrono::steady_clock::now();
+        bool ok = ExportAnalitic::scrie(sala, cale, optiuni);
+        secunde = secundeDe(start);
+        FILE* f = fopen(cale.c_str(), "rb");
+        long marime = -1;
+        if (ok && f) {
+            fseek(f, 0, SEEK_END);
+            marime = ftell(f);
+        }
+        if (f) fclose(f);
+        return static_cast<double>(marime);
+    };
+    double secundeFix, secundeComprimat;
+    const double octetiFix = scrie(false, secundeFix);
+    const double octetiComprimat = scrie(true, secundeComprimat);
+
+    size_t i = 0;
+    bool identic = true;
+    start = chrono::steady_clock::now();
+    bool citit = ExportAnalitic::citeste(cale, [&](const RandExport& r) {
+        const Client& c = sala[static_cast<int>(i++)];
+        const Abonament* ab = c.getAbonament();
+        identic = identic && r.nume == c.getNume() && r.telefon == c.getTelefon() && r.varsta == c.getVarsta() &&
+                  r.sold == c.getSold() && r.tip == c.getTipAbonament() && r.stare == (ab ? ab->getStare() : NEPROCURAT) &&
+                  r.pret == (ab ? ab->getPret() : Bani()) && r.durata == (ab ? ab->getDurata() : 0) &&
+                  r.procurare == (ab ? ab->getDataProcurarii() : Data()) &&
+                  r.activare == (ab ? ab->getDataActivarii() : Data()) &&
+                  r.expirare == (ab ? ab->getDataExpirarii() : Data());
+    });
+    double secundeCitire = secundeDe(start);
+    remove(cale.c_str());
+
+    bool ok = citit && identic && i == n && octetiComprimat > 0 && octetiComprimat < octetiFix;
+    auto linie = [&](const char* nume, double octeti, double secunde) {
+        cout << "  " << left << setw(26) << nume << right << setw(9) << setprecision(1) << octeti / (1 << 20)
+             << " MiB  " << setw(6) << setprecision(1) << octeti / n << " B/client  " << setw(8) << setprecision(3)
+             << secunde << " s   x" << setprecision(1) << octetiText / octeti << " mai mic\n";
+    };
+    cout << "\n== Export analitic (" << n << " clienti) ==\n" << fixed;
+    linie("text (afiseazaProfil)", octetiText, secundeText);
+    linie("coloane, latime fixa", octetiFix, secundeFix);
+    linie("coloane, comprimat", octetiComprimat, secundeComprimat);
+    cout << "  citire inapoi, comprimat   " << setw(8) << setprecision(3) << secundeCitire << " s\n"
+         << "  " << (ok ? "OK" : "ESEC: exportul citit inapoi difera de sala") << '\n';
+    return ok;
+}
+
+// ======================== AFISARE ========================
+// What console output used to cost: every line written out as soon as it ends,
+// as std::endl did, against an Afisaj over a TamponIesire and a silent Afisaj
+class IesireLinieCuLinie : public streambuf {
+private:
+    FILE* destinatie;
+
+protected:
+    int overflow(int c) override {
+        if (c == traits_type::eof()) return 0;
+        fputc(c, destinatie);
+        if (c == '\n') fflush(destinatie);
+        return c;
+    }
+
+    streamsize xsputn(const char* s, streamsize n) override {
+        fwrite(s, 1, static_cast<size_t>(n), destinatie);
+        if (memchr(s, '\n', static_cast<size_t>(n))) fflush(destinatie);
+        return n;
+    }
+
+public:
+    explicit IesireLinieCuLinie(FILE* destinatie) : destinatie(destinatie) {}
+};
+
+// A batch script (per member: registration, login, top-up, purchase, activation,
+// profile; every fourth activation fails) run the three ways. Both printed runs
+// must write the same text, and all three must leave the gym in the same state.
+bool benchmarkAfisare(size_t n) {
+    n = min<size_t>(n, 100000);   // one write(2) per line: keep the slow run short
+    vector<string> script;
+    script.reserve(n * 6);
+    for (size_t i = 0; i < n; i++) {
+        const string telefon = telefonSintetic(i);
+        script.push_back("inregistrare \"Client " + to_string(i) + "\" " + telefon + " parola " +
+                         to_string(14 + i % 87));
+        script.push_back("login " + telefon + " parola");
+        script.push_back(i % 4 == 0 ? "sold 100" : "sold 1000");
+        script.push_back(i % 2 == 0 ? "procura combinant 2025-01-10" : "procura fitness 2025-01-10");
+        script.push_back("activeaza 2025-01-10");
+        script.push_back("profil");
+    }
+
+    struct Rulare {
+        double secunde = 0;
+        string text;
+        int esuate = 0;
+        Bani sold;
+    };
+    const string cale = "bench_afisare.txt";
+    enum Mod { LINIE_CU_LINIE, TAMPONAT, TACUT };
+    auto ruleaza = [&](Mod mod) {
+        Rulare r;
+        Sala sala("Bench");
+        FILE* f = mod == TACUT ? nullptr : fopen(cale.c_str(), "wb");
+        if (mod != TACUT && !f) return r;
+        {
+            IesireLinieCuLinie linieCuLinie(f);
+            TamponIesire tampon(f);
+            ostream os(mod == TAMPONAT ? static_cast<streambuf*>(&tampon) : &linieCuLinie);
+            InterpretorComenzi interpretor(sala, mod == TACUT ? Afisaj() : Afisaj(os));
+            auto start = chrono::steady_clock::now();
+            for (const string& linie : script) r.esuate += !interpretor.executa(linie);
+            if (mod == TAMPONAT) tampon.goleste();
+            r.secunde = secundeDe(start);
+        }
+        r.sold = sala.soldTotal(FiltruClienti{});
+        if (!f) return r;
+        fclose(f);
+        ifstream in(cale, ios::binary);
+        r.text.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+        remove(cale.c_str());
+        return r;
+    };
+    const Rulare linie = ruleaza(LINIE_CU_LINIE), tampon = ruleaza(TAMPONAT), tacut = ruleaza(TACUT);
+
+    const bool ok = !linie.text.empty() && linie.text == tampon.text && linie.esuate == tampon.esuate &&
+                    linie.esuate == tacut.esuate && linie.sold == tampon.sold && linie.sold == tacut.sold;
+    auto raport = [&](const char* nume, const Rulare& r) {
+        cout << "  " << left << setw(28) << nume << right << setw(8) << setprecision(3) << r.secunde << " s  "
+             << setw(11) << setprecision(0) << static_cast<double>(script.size()) / r.secunde << " comenzi/s   x"
+             << setprecision(1) << linie.secunde / r.secunde << '\n';
+    };
+    cout << "\n== Afisare (" << n << " clienti, " << script.size() << " comenzi, " << fixed << setprecision(1)
+         << static_cast<double>(linie.text.size()) / (1 << 20) << " MiB de text) ==\n";
+    raport("golit la fiecare linie", linie);
+    raport("tamponat (TamponIesire)", tampon);
+    raport("tacut", tacut);
+    cout << "  " << (ok ? "OK" : "ESEC: rularile difera") << '\n';
+    return ok;
+}
+
+// ======================== SERVER ========================
+struct RezultatIncarcare {
+    uint64_t cereri = 0;
+    uint64_t esuate = 0;        // answers other than OK, and broken connections
+    Bani alimentat;             // acknowledged top-ups
+    double secunde = 0;
+    vector<uint32_t> latente;   // ns from sending a request to its answer
+};
+
+// Load generator: `conexiuni` sessions spread over `fire` threads, each thread
+// driving its sockets from one epoll set. Session i logs in as synthetic member
+// i, then keeps exactly one request in flight (closed loop) until `durata` is
+// over: 70% recomanda, 20% "sold 0.01", 10% "sesiune <token>" with the token
+// from that login (a turnstile reconnecting).
+RezultatIncarcare genereazaIncarcare(const string& adresa, size_t conexiuni, unsigned fire,
+                                     chrono::steady_clock::duration durata) {
+    struct Conexiune {
+        int fd = -1;
+        size_t client = 0;
+        string primit;
+        string token;
+        chrono::steady_clock::time_point trimisLa;
+        bool alimentare = false;   // the request in flight is a top-up
+    };
+
+    vector<RezultatIncarcare> partiale(fire);
+    const auto start = chrono::steady_clock::now();
+    vector<thread> lucratori;
+    for (unsigned k = 0; k < fire; k++)
+        lucratori.emplace_back([&, k] {
+            RezultatIncarcare& r = partiale[k];
+            mt19937 aleator(k + 1);
+            vector<Conexiune> conex;
+            for (size_t i = k; i < conexiuni; i += fire) conex.emplace_back().client = i;
+            int ep = epoll_create1(EPOLL_CLOEXEC);
+            size_t active = 0;
+
+            auto inchide = [&](Conexiune& c) {
+                close(c.fd);
+                c.fd = -1;
+                active--;
+            };
+            auto trimite = [&](Conexiune& c, bool login) {
+                char cerere[64];
+                unsigned tip = aleator() % 10;
+                c.alimentare = !login && tip >= 7 && tip < 9;
+                int lungime = login    ? snprintf(cerere, sizeof(cerere), "login %s parola%zu\n",
+                                                  telefonSintetic(c.client).c_str(), c.client % 1000)
+                              : tip == 9 ? snprintf(cerere, sizeof(cerere), "sesiune %s\n", c.token.c_str())
+                                         : snprintf(cerere, sizeof(cerere), c.alimentare ? "sold 0.01\n" : "recomanda\n");
+                c.trimisLa = chrono::steady_clock::now();
+                if (send(c.fd, cerere, static_cast<size_t>(lungime), MSG_NOSIGNAL) != lungime) {
+                    r.esuate++;
+                    inchide(c);
+                }
+            };
+
+            for (Conexiune& c : conex) {
+                c.fd = ServerSala::conecteaza(adresa);
+                if (c.fd < 0) {
+                    r.esuate++;
+                    continue;
+                }
+                fcntl(c.fd, F_SETFL, fcntl(c.fd, F_GETFL) | O_NONBLOCK);
+                epoll_event ev{};
+                ev.events = EPOLLIN;
+                ev.data.ptr = &c;
+                epoll_ctl(ep, EPOLL_CTL_ADD, c.fd, &ev);
+                active++;
+                trimite(c, true);
+            }
+
+            epoll_event evenimente[256];
+            char buffer[4096];
+            while (active > 0) {
+                int n = epoll_wait(ep, evenimente, 256, 100);
+                for (int e = 0; e < n; e++) {
+                    Conexiune& c = *static_cast<Conexiune*>(evenimente[e].data.ptr);
+                    if (c.fd < 0) continue;
+                    ssize_t m = read(c.fd, buffer, sizeof(buffer));
+                    if (m < 0 && (errno == EAGAIN || errno == EINTR)) continue;
+                    if (m <= 0) {
+                        r.esuate++;
+                        inchide(c);
+                        continue;
+                    }
+                    c.primit.append(buffer, static_cast<size_t>(m));
+                    size_t sfarsit = c.primit.find('\n');
+                    if (sfarsit == string::npos) continue;
+
+                    auto acum = chrono::steady_clock::now();
+                    r.latente.push_back(static_cast<uint32_t>(chrono::duration_cast<chrono::nanoseconds>(acum - c.trimisLa).count()));
+                    r.cereri++;
+                    if (c.primit.compare(0, 2, "OK") != 0) r.esuate++;
+                    else if (c.alimentare) r.alimentat += 1_bani;
+                    else if (c.token.empty()) c.token = c.primit.substr(3, sfarsit - 3);
+                    c.primit.erase(0, sfarsit + 1);
+                    if (acum - start >= durata) inchide(c);
+                    else trimite(c, false);
+                }
+            }
+            close(ep);
+        });
+    for (thread& t : lucratori) t.join();
+
+    RezultatIncarcare total;
+    total.secunde = secundeDe(start);
+    for (RezultatIncarcare& r : partiale) {
+        total.cereri += r.cereri;
+        total.esuate += r.esuate;
+        total.alimentat += r.alimentat;
+        total.latente.insert(total.latente.end(), r.latente.begin(), r.latente.end());
+    }
+    return total;
+}
+
+// The server against the load generator on the same machine: over a Unix socket
+// and TCP loopback without a journal, then over the Unix socket with one (every
+// answer then waits for its group fsync). Afterwards every acknowledged top-up
+// must show in the balances, and the balances must still match the ledger.
+bool benchmarkServer(size_t conexiuni) {
+    // Both ends of every connection live in this process
+    rlimit limita;
+    if (getrlimit(RLIMIT_NOFILE, &limita) == 0 && limita.rlim_cur < limita.rlim_max) {
+        limita.rlim_cur = limita.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limita);
+    }
+    const unsigned fireServer = 2, fireGenerator = 2;
+    const string caleSocket = "bench_server.sock", caleJurnal = "bench_server.wal";
+    Sala sala("Bench");
+    populeazaSala(sala, conexiuni);
+
+    cout << "\n== Server (" << conexiuni << " conexiuni, " << fireServer << " fire server, "
+         << thread::hardware_concurrency() << " nuclee) ==\n";
+    struct Varianta {
+        const char* nume;
+        string adresa;
+        bool cuJurnal;
+    };
+    bool ok = true;
+    for (const Varianta& v : {Varianta{"unix", caleSocket, false}, Varianta{"tcp 127.0.0.1", "0", false},
+                              Varianta{"unix + jurnal", caleSocket, true}}) {
+        remove(caleJurnal.c_str());
+        unique_ptr<Jurnal> jurnal;
+        if (v.cuJurnal) {
+            jurnal = make_unique<Jurnal>(caleJurnal, sala.getUltimaSecventa());
+            sala.ataseazaJurnal(jurnal.get());
+        }
+        const Bani inainte = sala.soldTotal(FiltruClienti{});
+        RezultatIncarcare r;
+        {
+            ServerSala server(sala, fireServer);
+            if (!server.asculta(v.adresa)) {
+                cout << "  " << v.nume << ": nu pot asculta pe " << v.adresa << '\n';
+                ok = false;
+                continue;
+            }
+            string tinta = v.adresa == "0" ? to_string(server.getPort()) : v.adresa;
+            thread fir([&] { server.ruleaza(); });
+            r = genereazaIncarcare(tinta, conexiuni, fireGenerator, chrono::seconds(1));
+            server.opreste();
+            fir.join();
+        }
+        sala.ataseazaJurnal(nullptr);
+        jurnal.reset();
+        ok = ok && r.cereri > 0 && r.esuate == 0 && sala.soldTotal(FiltruClienti{}) == inainte + r.alimentat;
+
+        auto percentila = [&](double p) {
+            auto it = r.latente.begin() + static_cast<ptrdiff_t>(p * static_cast<double>(r.latente.size() - 1));
+            nth_element(r.latente.begin(), it, r.latente.end());
+            return *it / 1000.0;
+        };
+        double p50 = r.latente.empty() ? 0 : percentila(0.50), p99 = r.latente.empty() ? 0 : percentila(0.99);
+        cout << "  " << left << setw(16) << v.nume << right << setw(10) << fixed << setprecision(0)
+             << static_cast<double>(r.cereri) / r.secunde << " cereri/s   p50 " << setprecision(1) << p50
+             << " us   p99 " << p99 << " us   esuate " << r.esuate << '\n';
+    }
+    remove(caleJurnal.c_str());
+    ok = ok && sala.reconciliazaSolduri().ok();
+    cout << "  " << (ok ? "OK" : "ESEC: cereri esuate sau solduri diferite de alimentarile confirmate") << '\n';
+    return ok;
+}
+#endif
+
+// Cost of the latency instrumentation: the same lookups with metrics off and on
+void benchmarkMetrici(size_t n) {
+    Sala sala("Bench");
+    populeazaSala(sala, n);
+    vector<string> telefoane(n);
+    for (size_t i = 0; i < n; i++) telefoane[i] = telefonSintetic(i);
+    const size_t operatii = 2000000;
+
+    auto ruleaza = [&] {
+        return nsPeOperatie(operatii, [&] {
+            long long gasiti = 0;
+            for (size_t k = 0; k < operatii; k++)
+                gasiti += sala(telefoane[(k * 7919) % n]) != nullptr;
+            rezervor = gasiti;
+        });
+    };
+
+    cout << "\n== Metrici (" << n << " clienti, operator()) ==\n";
+    Metrici::activeaza(false);
+    double oprit = ruleaza();
+    Metrici::activeaza(true);
+    double pornit = ruleaza();
+    Metrici::activeaza(false);
+    raportMicro("metrici oprite", oprit, oprit);
+    raportMicro("metrici pornite", pornit, oprit);
+    StatisticaOperatie s = Metrici::statistica(Operatie::SALA_CAUTARE);
+    cout << "  inregistrate: " << s.apeluri << " apeluri, p50 " << s.percentila(0.50)
+         << " ns, p99 " << s.percentila(0.99) << " ns\n";
+    Metrici::reseteaza();
+}
+
+// ======================== MAIN ========================
+// Usage: POO_Lab_4_bench [sectiune [numar_clienti]]   (no argument runs every section)
+// Sections: validare, snapshot, jurnal, operatii (1k/100k/1M clients unless a count is given),
+//           copiere, alocari, coloane, bonus, registru, concurent, recomandari, indexuri, intervale,
+//           sesiuni, import, export, afisare, server (Linux; the count is the number of connections, 1000 by default), metrici
+int main(int argc, char* argv[]) {
+    const char* sectiune = argc > 1 ? argv[1] : "";
+    bool toate = sectiune[0] == '\0';
+    size_t numarClienti = argc > 2 ? strtoull(argv[2], nullptr, 10) : 1000000;
+
+    if (toate || strcmp(sectiune, "validare") == 0) benchmarkValidare();
+    if (toate || strcmp(sectiune, "snapshot") == 0) benchmarkSnapshot(numarClienti);
+    if (toate || strcmp(sectiune, "jurnal") == 0)   benchmarkJurnal(numarClienti);
+    if (toate || strcmp(sectiune, "operatii") == 0) {
+        cout << "\n== Operatii Sala ==\n";
+        Latente::antet();
+        if (argc > 2) {
+            benchmarkOperatii(numarClienti);
+        } else {
+            for (size_t n : {size_t(1000), size_t(100000), size_t(1000000)}) benchmarkOperatii(n);
+        }
+    }
+    if (toate || strcmp(sectiune, "copiere") == 0)  benchmarkCopiere(numarClienti);
+    bool ok = true;
+    if (toate || strcmp(sectiune, "alocari") == 0)  ok = benchmarkAlocari(numarClienti);
+    if (toate || strcmp(sectiune, "coloane") == 0)  benchmarkColoane(numarClienti);
+    if (toate || strcmp(sectiune, "bonus") == 0)    benchmarkBonus(numarClienti);
+    if (toate || strcmp(sectiune, "registru") == 0) ok = benchmarkRegistru(numarClienti) && ok;
+    if (toate || strcmp(sectiune, "concurent") == 0) ok = benchmarkConcurent(numarClienti) && ok;
+    if (toate || strcmp(sectiune, "recomandari") == 0) ok = benchmarkRecomandari(numarClienti) && ok;
+    if (toate || strcmp(sectiune, "indexuri") == 0) ok = benchmarkIndexuri(numarClienti) && ok;
+    if (toate || strcmp(sectiune, "intervale") == 0) ok = benchmarkIntervale(numarClienti) && ok;
+    if (toate || strcmp(sectiune, "sesiuni") == 0) ok = benchmarkSesiuni(numarClienti) && ok;
+    if (toate || strcmp(sectiune, "import") == 0)  ok = benchmarkImport(numarClienti) && ok;
+    if (toate || strcmp(sectiune, "export") == 0)  ok = benchmarkExport(numarClienti) && ok;
+    if (toate || strcmp(sectiune, "afisare") == 0) ok = benchmarkAfisare(numarClienti) && ok;
+#if defined(__linux__)
+    if (toate || strcmp(sectiune, "server") == 0) ok = benchmarkServer(argc > 2 ? numarClienti : 1000) && ok;
+#endif
+    if (toate || strcmp(sectiune, "metrici") == 0)  benchmarkMetrici(numarClienti);
+    return ok ? 0 : 1;
+}